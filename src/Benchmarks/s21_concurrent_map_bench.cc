@@ -0,0 +1,75 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../s21_concurrent_map.h"
+#include "../s21_map.h"
+
+//  Write-heavy mix (50% upsert, 25% erase, 25% lookup) on concurrent_map
+//  against one s21::map behind a global mutex, 1 to 64 threads.
+//  Usage: s21_concurrent_map_bench [max_threads] [milliseconds_per_run]
+
+namespace {
+constexpr int kKeys = 1 << 16;
+
+template <class Op>
+double Run(int threads, int millis, Op op) {
+  std::atomic<bool> done{false};
+  std::atomic<long> total{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      unsigned seed = t + 1;
+      long count = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        seed = seed * 1103515245 + 12345;
+        op(int(seed >> 16) % kKeys, seed & 3);
+        ++count;
+      }
+      total += count;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+  done = true;
+  for (auto &worker : workers) worker.join();
+  return total / (millis / 1000.0) / 1e6;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+  int millis = argc > 2 ? std::atoi(argv[2]) : 500;
+
+  std::cout << "threads  concurrent_map Mops/s  mutex+map Mops/s\n";
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    s21::concurrent_map<int, int, 64> sharded;
+    double sharded_rate = Run(threads, millis, [&](int key, unsigned kind) {
+      if (kind < 2) {
+        sharded.upsert(key, key);
+      } else if (kind == 2) {
+        sharded.erase(key);
+      } else {
+        sharded.contains(key);
+      }
+    });
+    s21::map<int, int> locked;
+    std::mutex lock;
+    double lock_rate = Run(threads, millis, [&](int key, unsigned kind) {
+      std::lock_guard<std::mutex> guard(lock);
+      if (kind < 2) {
+        locked.insert_or_assign(key, key);
+      } else if (kind == 2) {
+        locked.erase(key);
+      } else {
+        locked.contains(key);
+      }
+    });
+    std::cout << threads << "\t " << sharded_rate << "\t\t\t " << lock_rate
+              << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,83 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../s21_concurrent_map.h"
+#include "../s21_concurrent_unordered_map.h"
+
+//  Throughput of concurrent_unordered_map against the sharded
+//  concurrent_map for 1 to max_threads threads, at three mixes of
+//  lookups / upserts / erases: read-heavy 90/5/5, mixed 50/25/25 and
+//  write-heavy 10/45/45. Each run starts from an empty table and grows.
+//  Usage: s21_concurrent_unordered_map_bench [max_threads] [milliseconds]
+
+namespace {
+constexpr int kKeys = 1 << 18;
+
+struct Mix {
+  const char *name;
+  unsigned reads;  //  Out of 100, the rest split between upsert and erase
+};
+
+template <class Op>
+double Run(int threads, int millis, Op op) {
+  std::atomic<bool> done{false};
+  std::atomic<long> total{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      unsigned seed = t + 1;
+      long count = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        seed = seed * 1103515245 + 12345;
+        op(int(seed >> 8) % kKeys, (seed >> 1) % 100);
+        ++count;
+      }
+      total += count;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+  done = true;
+  for (auto &worker : workers) worker.join();
+  return total / (millis / 1000.0) / 1e6;
+}
+
+template <class Map>
+void Apply(Map &map, const Mix &mix, int key, unsigned roll) {
+  if (roll < mix.reads) {
+    map.contains(key);
+  } else if ((roll - mix.reads) % 2 == 0) {
+    map.upsert(key, key);
+  } else {
+    map.erase(key);
+  }
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+  int millis = argc > 2 ? std::atoi(argv[2]) : 500;
+  const Mix mixes[] = {{"read-heavy", 90}, {"mixed", 50}, {"write-heavy", 10}};
+
+  for (const Mix &mix : mixes) {
+    std::cout << mix.name
+              << "\nthreads  concurrent_unordered_map Mops/s  "
+                 "concurrent_map Mops/s\n";
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+      s21::concurrent_unordered_map<int, int> hashed;
+      double hashed_rate = Run(threads, millis, [&](int key, unsigned roll) {
+        Apply(hashed, mix, key, roll);
+      });
+      s21::concurrent_map<int, int, 64> sharded;
+      double sharded_rate = Run(threads, millis, [&](int key, unsigned roll) {
+        Apply(sharded, mix, key, roll);
+      });
+      std::cout << threads << "\t " << hashed_rate << "\t\t\t\t "
+                << sharded_rate << "\n";
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "../s21_hash.h"
+
+//  Throughput, collisions and avalanche of s21::hash against std::hash.
+//  Collisions are counted over the full 64 bits and over the low bits a
+//  power of two table would use as its bucket index.
+//  Usage: s21_hash_bench [file with one key per line]
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+template <class Fn>
+double Measure(Fn fn) {
+  auto start = Clock::now();
+  fn();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//  Keys in the shapes our tables see: decimal ids, URLs with a shared
+//  prefix, and random bytes
+std::vector<std::string> Corpus(const std::string &kind, std::size_t count) {
+  std::mt19937_64 rng(11);
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (kind == "ids") {
+      keys.push_back(std::to_string(i));
+    } else if (kind == "urls") {
+      keys.push_back("https://example.com/users/" + std::to_string(i) +
+                     "/profile");
+    } else {
+      std::string key(8 + rng() % 24, '\0');
+      for (char &c : key) c = static_cast<char>(rng());
+      keys.push_back(key);
+    }
+  }
+  return keys;
+}
+
+template <class Hash>
+void Collisions(const char *name, const std::vector<std::string> &keys) {
+  constexpr unsigned kBits = 20;
+  std::unordered_set<std::uint64_t> full;
+  std::vector<std::uint32_t> buckets(1u << kBits);
+  Hash hash;
+  for (const auto &key : keys) {
+    std::uint64_t value = hash(key);
+    full.insert(value);
+    ++buckets[value & ((1u << kBits) - 1)];
+  }
+  //  Keys sharing a bucket with an earlier key, and the same for a
+  //  uniformly random function
+  std::size_t shared = 0;
+  for (std::uint32_t n : buckets) shared += n > 1 ? n - 1 : 0;
+  double m = buckets.size(), n = keys.size();
+  double expected = n - m * (1 - std::pow(1 - 1 / m, n));
+  std::cout << "  " << name << ": 64-bit " << keys.size() - full.size()
+            << ", low " << kBits << " bits " << shared << " (random "
+            << std::size_t(expected) << ")\n";
+}
+
+//  Largest deviation from 1/2 of P(output bit j flips | input bit i flips)
+template <class Fn>
+double WorstBias(Fn fn, std::size_t input_bits) {
+  std::mt19937_64 rng(7);
+  constexpr int kSamples = 2000;
+  double worst = 0;
+  for (std::size_t bit = 0; bit < input_bits; ++bit) {
+    std::vector<int> flips(64);
+    for (int i = 0; i < kSamples; ++i) {
+      std::bitset<64> diff(fn(rng(), bit));
+      for (int out = 0; out < 64; ++out) flips[out] += diff[out];
+    }
+    for (int out = 0; out < 64; ++out) {
+      worst = std::max(worst, std::abs(double(flips[out]) / kSamples - 0.5));
+    }
+  }
+  return worst;
+}
+
+template <class Hash>
+double StringBias(std::size_t len) {
+  Hash hash;
+  return WorstBias(
+      [&](std::uint64_t seed, std::size_t bit) {
+        std::string key(len, '\0');
+        for (std::size_t i = 0; i < len; ++i) {
+          std::uint64_t word = s21::hash_mix(seed + i / 8);
+          key[i] = static_cast<char>(word >> i % 8 * 8);
+        }
+        std::uint64_t before = hash(key);
+        key[bit / 8] ^= char(1 << (bit % 8));
+        return before ^ hash(key);
+      },
+      len * 8);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t checksum = 0;
+  std::cout << "string throughput, GB/s (s21::hash / std::hash)\n";
+  for (std::size_t len : {4, 16, 64, 256, 1024, 16384}) {
+    std::vector<std::string> keys(4096, std::string(len, 'x'));
+    std::mt19937_64 rng(3);
+    for (auto &key : keys) {
+      for (char &c : key) c = static_cast<char>(rng());
+    }
+    std::size_t rounds = std::max<std::size_t>(1, (64 << 20) / (len * 4096));
+    double bytes = double(rounds) * keys.size() * len;
+    auto run = [&](auto hash) {
+      return bytes / Measure([&] {
+               for (std::size_t r = 0; r < rounds; ++r) {
+                 for (const auto &key : keys) {
+                   checksum += hash(std::string_view(key));
+                 }
+               }
+             }) / 1e9;
+    };
+    double ours = run(s21::hash<std::string_view>());
+    double theirs = run(std::hash<std::string_view>());
+    std::cout << "  " << len << " bytes: " << ours << " / " << theirs << "\n";
+  }
+
+  constexpr std::uint64_t kInts = 1 << 26;
+  double ours = Measure([&] {
+    for (std::uint64_t i = 0; i < kInts; ++i) checksum += s21::hash_mix(i);
+  });
+  std::cout << "integer mix: " << ours * 1e9 / kInts << " ns\n";
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> corpora;
+  for (const char *kind : {"ids", "urls", "random"}) {
+    corpora.emplace_back(kind, Corpus(kind, 1 << 20));
+  }
+  if (argc > 1) {
+    std::ifstream in(argv[1]);
+    std::vector<std::string> keys;
+    for (std::string line; std::getline(in, line);) keys.push_back(line);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    corpora.emplace_back(argv[1], keys);
+  }
+  std::cout << "collisions\n";
+  for (const auto &[name, keys] : corpora) {
+    std::cout << " " << name << " (" << keys.size() << " keys)\n";
+    Collisions<s21::hash<std::string>>("s21::hash", keys);
+    Collisions<std::hash<std::string>>("std::hash", keys);
+  }
+
+  std::cout << "avalanche, worst bit bias (0 is ideal)\n";
+  auto int_bias = [](auto hash) {
+    return WorstBias(
+        [&](std::uint64_t x, std::size_t bit) {
+          return std::uint64_t(hash(x) ^ hash(x ^ (1ull << bit)));
+        },
+        64);
+  };
+  std::cout << "  uint64_t: " << int_bias(s21::hash<std::uint64_t>())
+            << " / " << int_bias(std::hash<std::uint64_t>()) << "\n";
+  for (std::size_t len : {8, 32, 300}) {
+    std::cout << "  " << len
+              << "-byte string: " << StringBias<s21::hash<std::string>>(len)
+              << " / " << StringBias<std::hash<std::string>>(len) << "\n";
+  }
+  std::cout << "checksum " << checksum % 10 << "\n";
+}
@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "../s21_unordered_map.h"
+
+//  Per-insert latency while filling a table from empty: unordered_map
+//  stops for a full rehash at every doubling, incremental_unordered_map
+//  moves kMigrateSlots old slots per insert instead. Reports the mean,
+//  p99.9 and max of single inserts.
+//  Usage: s21_incremental_rehash_bench [keys]
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+template <class Map>
+void Run(const char *name, const std::vector<long> &keys) {
+  std::vector<double> latency(keys.size());
+  Map map;
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    auto start = Clock::now();
+    map.insert(keys[i], keys[i]);
+    latency[i] = std::chrono::duration<double, std::nano>(Clock::now() -
+                                                          start)
+                     .count();
+  }
+  double total = 0;
+  for (double ns : latency) total += ns;
+  std::size_t p999 = latency.size() - latency.size() / 1000 - 1;
+  std::nth_element(latency.begin(), latency.begin() + p999, latency.end());
+  double tail = latency[p999];
+  double worst = *std::max_element(latency.begin() + p999, latency.end());
+  std::cout << name << ": mean " << total / keys.size() << " ns, p99.9 "
+            << tail << " ns, max " << worst / 1e6 << " ms, size "
+            << map.size() << "\n";
+}
+
+template <class Key, class T>
+struct StdMap : std::unordered_map<Key, T> {
+  void insert(const Key &key, const T &value) {
+    std::unordered_map<Key, T>::emplace(key, value);
+  }
+};
+}  // namespace
+
+int main(int argc, char **argv) {
+  long count = argc > 1 ? std::atol(argv[1]) : 8000000;
+  std::mt19937_64 rng(1);
+  std::vector<long> keys(count);
+  for (long &key : keys) key = long(rng() >> 1);
+
+  Run<StdMap<long, long>>("std::unordered_map", keys);
+  Run<s21::unordered_map<long, long>>("unordered_map", keys);
+  Run<s21::incremental_unordered_map<long, long>>("incremental_unordered_map",
+                                                  keys);
+  return 0;
+}
@@ -0,0 +1,44 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "../s21_map.h"
+
+//  Appends time-ordered keys to s21::map with and without an end() hint.
+//  The tree is not self-balancing, so plain in-order inserts degrade into
+//  a list walk and that run is capped to keep the benchmark finite.
+//  Usage: s21_map_hint_bench [hinted_keys] [unhinted_keys]
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+template <class Fn>
+double Measure(Fn fn) {
+  auto start = Clock::now();
+  fn();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void Report(const char *name, long keys, double seconds) {
+  std::cout << name << ": " << keys << " keys in " << seconds << " s, "
+            << seconds * 1e9 / keys << " ns/insert\n";
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  long hinted = argc > 1 ? std::atol(argv[1]) : 10000000;
+  long unhinted = argc > 2 ? std::atol(argv[2]) : 20000;
+
+  s21::map<long, long> a;
+  double seconds = Measure([&] {
+    for (long i = 0; i < hinted; ++i) a.emplace_hint(a.end(), i, i);
+  });
+  Report("hinted", hinted, seconds);
+
+  s21::map<long, long> b;
+  seconds = Measure([&] {
+    for (long i = 0; i < unhinted; ++i) b.insert(i, i);
+  });
+  Report("unhinted", unhinted, seconds);
+  return (a.size() == size_t(hinted) && b.size() == size_t(unhinted)) ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#include <malloc.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "../s21_list.h"
+#include "../s21_map.h"
+#include "../s21_ordered_hash_map.h"
+
+//  Heap use and insertion-order iteration of ordered_hash_map against the
+//  s21::list of keys plus s21::map index it replaces.
+//  Usage: s21_ordered_hash_map_bench [keys]
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+//  Heap bytes in use, counting malloc's per-block overhead and mmapped
+//  large blocks
+std::size_t Allocated() {
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+}
+
+template <class Fn>
+double Measure(Fn fn) {
+  auto start = Clock::now();
+  fn();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  long keys = argc > 1 ? std::atol(argv[1]) : 1000000;
+  long checksum = 0;
+  {
+    std::size_t before = Allocated();
+    s21::list<long> order;
+    s21::map<long, long> index;
+    for (long i = 0; i < keys; ++i) {
+      long key = (i * 2654435761L) % (keys * 4);
+      if (index.insert(key, i).second) order.push_back(key);
+    }
+    std::cout << "list+map: " << double(Allocated() - before) / keys
+              << " bytes/entry, scan "
+              << Measure([&] {
+                   for (long key : order) checksum += index.at(key);
+                 }) * 1e9 / keys
+              << " ns/entry\n";
+  }
+  {
+    std::size_t before = Allocated();
+    s21::ordered_hash_map<long, long> map;
+    for (long i = 0; i < keys; ++i) {
+      map.insert((i * 2654435761L) % (keys * 4), i);
+    }
+    std::cout << "ordered_hash_map: " << double(Allocated() - before) / keys
+              << " bytes/entry, scan "
+              << Measure([&] {
+                   for (const auto &item : map) checksum -= item.second;
+                 }) * 1e9 / keys
+              << " ns/entry\n";
+  }
+  return checksum == 0 ? 0 : 1;
+}
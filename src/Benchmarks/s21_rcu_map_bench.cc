@@ -0,0 +1,83 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_rcu_map.h"
+
+//  Lookup throughput of rcu_map against a mutex guarded s21::map while a
+//  writer updates a few times per second.
+//  Usage: s21_rcu_map_bench [max_threads] [milliseconds_per_run]
+
+namespace {
+constexpr int kKeys = 1 << 16;
+
+template <class Lookup, class Update>
+double Run(int threads, int millis, Lookup lookup, Update update) {
+  std::atomic<bool> done{false};
+  std::atomic<long> total{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < threads; ++t) {
+    readers.emplace_back([&, t] {
+      unsigned seed = t + 1;
+      long count = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        seed = seed * 1103515245 + 12345;
+        count += lookup(int(seed >> 16) % kKeys);
+      }
+      total += count;
+    });
+  }
+  auto stop = std::chrono::steady_clock::now() + std::chrono::milliseconds(millis);
+  for (int i = 0; std::chrono::steady_clock::now() < stop; ++i) {
+    update(i % kKeys);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+  done = true;
+  for (auto &reader : readers) reader.join();
+  return total / (millis / 1000.0) / 1e6;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  int max_threads = argc > 1 ? std::atoi(argv[1]) : 32;
+  int millis = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+  s21::rcu_map<int, int> rcu;
+  rcu.update([](auto &map) {
+    for (int i = 0; i < kKeys; ++i) map.insert(i, i);
+  });
+  s21::map<int, int> locked;
+  std::mutex lock;
+  s21::vector<s21::map<int, int>::batch_op> ops(kKeys);
+  s21::vector<s21::map<int, int>::batch_result> results(kKeys);
+  for (int i = 0; i < kKeys; ++i) ops[i] = {{}, i, i};
+  locked.apply_batch(ops.data(), ops.data() + kKeys, results.data());
+
+  std::cout << "threads  rcu_map Mops/s  mutex+map Mops/s\n";
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    double rcu_rate = Run(
+        threads, millis,
+        [&](int key) {
+          int value = 0;
+          return rcu.find(key, value) ? 1 : 0;
+        },
+        [&](int key) { rcu.insert_or_assign(key, -key); });
+    double lock_rate = Run(
+        threads, millis,
+        [&](int key) {
+          std::lock_guard<std::mutex> guard(lock);
+          return locked.contains(key) ? 1 : 0;
+        },
+        [&](int key) {
+          std::lock_guard<std::mutex> guard(lock);
+          locked.insert_or_assign(key, -key);
+        });
+    std::cout << threads << "\t " << rcu_rate << "\t\t " << lock_rate << "\n";
+  }
+  return 0;
+}
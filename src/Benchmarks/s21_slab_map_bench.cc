@@ -0,0 +1,65 @@
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_slab_map.h"
+
+//  Random lookups and a full value scan over s21::map and s21::slab_map
+//  holding 200-byte values. slab_map nodes carry only the key, so a lookup
+//  walks a quarter of the cache lines.
+//  Usage: s21_slab_map_bench [keys] [lookups]
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using Value = std::array<char, 200>;
+
+template <class Fn>
+double Measure(Fn fn) {
+  auto start = Clock::now();
+  fn();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void Report(const char *name, long ops, double seconds) {
+  std::cout << name << ": " << seconds * 1e9 / ops << " ns/op\n";
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  long keys = argc > 1 ? std::atol(argv[1]) : 1000000;
+  long lookups = argc > 2 ? std::atol(argv[2]) : 2000000;
+  std::mt19937_64 rng(1);
+  std::vector<long> order(keys);
+  for (long i = 0; i < keys; ++i) order[i] = long(rng() >> 1);
+
+  s21::map<long, Value> inline_map;
+  s21::slab_map<long, Value> slab;
+  //  Filled one after the other so their nodes do not interleave
+  for (long key : order) inline_map.insert(key, Value{char(key)});
+  for (long key : order) slab.insert(key, Value{char(key)});
+
+  long checksum = 0;
+  Report("map lookup", lookups, Measure([&] {
+           for (long i = 0; i < lookups; ++i) {
+             checksum += inline_map.find(order[i % keys])->second[0];
+           }
+         }));
+  Report("slab_map lookup", lookups, Measure([&] {
+           for (long i = 0; i < lookups; ++i) {
+             checksum -= slab.find(order[i % keys])->second[0];
+           }
+         }));
+  Report("map value scan", keys, Measure([&] {
+           for (auto &item : inline_map) checksum += item.second[0];
+         }));
+  Report("slab_map value scan", keys, Measure([&] {
+           for (Value *v = slab.values_begin(); v != slab.values_end(); ++v) {
+             checksum -= (*v)[0];
+           }
+         }));
+  return checksum == 0 ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_unordered_map.h"
+
+//  Insert, successful lookup, failed lookup and erase over s21::map,
+//  std::unordered_map and s21::unordered_map with random 64-bit keys.
+//  Usage: s21_unordered_map_bench [keys]
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+template <class Fn>
+double Measure(Fn fn) {
+  auto start = Clock::now();
+  fn();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void Report(const char *name, const char *op, long ops, double seconds) {
+  std::cout << name << " " << op << ": " << seconds * 1e9 / ops
+            << " ns/op\n";
+}
+
+template <class Map>
+long Run(const char *name, const std::vector<long> &keys,
+         const std::vector<long> &misses) {
+  long count = long(keys.size());
+  long checksum = 0;
+  Map map;
+  Report(name, "insert", count, Measure([&] {
+           for (long key : keys) map.insert(key, key);
+         }));
+  Report(name, "hit", count, Measure([&] {
+           for (long key : keys) checksum += map.find(key)->second;
+         }));
+  Report(name, "miss", count, Measure([&] {
+           for (long key : misses) checksum += map.contains(key);
+         }));
+  Report(name, "erase", count, Measure([&] {
+           for (long key : keys) checksum += map.erase(key);
+         }));
+  return checksum;
+}
+
+//  std::unordered_map has no insert(key, value) or contains in C++17
+template <class Key, class T>
+struct StdMap : std::unordered_map<Key, T> {
+  void insert(const Key &key, const T &value) {
+    std::unordered_map<Key, T>::emplace(key, value);
+  }
+  bool contains(const Key &key) const { return this->count(key) != 0; }
+};
+}  // namespace
+
+int main(int argc, char **argv) {
+  long count = argc > 1 ? std::atol(argv[1]) : 1000000;
+  std::mt19937_64 rng(1);
+  std::vector<long> keys(count), misses(count);
+  for (long i = 0; i < count; ++i) keys[i] = long(rng() >> 1) | 1;
+  for (long i = 0; i < count; ++i) misses[i] = long(rng() >> 1) & ~1L;
+
+  long checksum = Run<s21::map<long, long>>("map", keys, misses);
+  checksum += Run<StdMap<long, long>>("std::unordered_map", keys, misses);
+  checksum +=
+      Run<s21::unordered_map<long, long>>("unordered_map", keys, misses);
+  return checksum == 0 ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../s21_vector.h"
+
+//  Cost of the reallocations while a vector grows by push_back: strings,
+//  which are moved, and shared_ptr, opted into memcpy relocation. Each
+//  row reports the build time and the time spent in a final doubling.
+//  Usage: s21_vector_growth_bench [elements]
+
+template <class T>
+struct s21::is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+template <class Fn>
+double Measure(Fn fn) {
+  auto start = Clock::now();
+  fn();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <class Vector, class Make>
+void Run(const char *name, long count, Make make) {
+  Vector values;
+  double build = Measure([&] {
+    for (long i = 0; i < count; ++i) values.push_back(make(i));
+  });
+  double grow = Measure([&] { values.reserve(values.capacity() * 2); });
+  std::cout << name << ": build " << build * 1e9 / count
+            << " ns/element, doubling " << grow * 1e3 << " ms\n";
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  long count = argc > 1 ? std::atol(argv[1]) : 2000000;
+  auto text = [](long i) { return std::string(48, char('a' + i % 26)); };
+  auto owned = [](long i) { return std::make_shared<long>(i); };
+  Run<s21::vector<std::string>>("s21::vector<string>", count, text);
+  Run<std::vector<std::string>>("std::vector<string>", count, text);
+  Run<s21::vector<std::shared_ptr<long>>>("s21::vector<shared_ptr>", count,
+                                           owned);
+  Run<std::vector<std::shared_ptr<long>>>("std::vector<shared_ptr>", count,
+                                           owned);
+}
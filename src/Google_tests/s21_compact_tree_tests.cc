@@ -0,0 +1,193 @@
+#include <cstdint>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include "../s21_compact_tree.h"
+#include "gtest/gtest.h"
+
+template <typename Tree, typename Std>
+bool compare_tree(const Tree &tree, const Std &std_tree) {
+  if (tree.size() != std_tree.size()) return false;
+  auto i2 = tree.begin();
+  for (auto i1 = std_tree.begin(); i1 != std_tree.end(); ++i1, ++i2) {
+    if (*i1 != *i2) return false;
+  }
+  return i2 == tree.end();
+}
+
+TEST(CompactSetTest, DefaultConstructor) {
+  s21::compact_set<int> a;
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.size(), 0);
+  EXPECT_TRUE(a.begin() == a.end());
+}
+
+TEST(CompactSetTest, ListInit) {
+  s21::compact_set<int> a = {9, 10, 123, -4, 10};
+  std::set<int> b = {9, 10, 123, -4, 10};
+  EXPECT_TRUE(compare_tree(a, b));
+}
+
+TEST(CompactSetTest, Insert) {
+  s21::compact_set<std::string> a;
+  EXPECT_TRUE(a.insert("bbb").second);
+  EXPECT_TRUE(a.insert("aaa").second);
+  EXPECT_FALSE(a.insert("bbb").second);
+  EXPECT_EQ(*a.insert("ccc").first, "ccc");
+  EXPECT_EQ(a.size(), 3);
+  EXPECT_TRUE(a.contains("aaa"));
+  EXPECT_FALSE(a.contains("ddd"));
+  EXPECT_EQ(*a.find("bbb"), "bbb");
+  EXPECT_TRUE(a.find("ddd") == a.end());
+}
+
+TEST(CompactSetTest, InsertManyMovesKeys) {
+  s21::compact_set<std::string> a;
+  std::string key(64, 'x');
+  auto results = a.insert_many(std::move(key), std::string(64, 'y'),
+                               std::string(64, 'x'));
+  EXPECT_TRUE(key.empty());
+  EXPECT_EQ(results.size(), 3);
+  EXPECT_TRUE(results[1].second);
+  EXPECT_FALSE(results[2].second);
+  EXPECT_EQ(a.size(), 2);
+}
+
+TEST(CompactSetTest, Erase) {
+  s21::compact_set<int> a = {9, 10, 123, -4, 45, 1, 76, 34, 57, 5, 3, -7};
+  std::set<int> b = {9, 10, 123, -4, 45, 1, 76, 34, 57, 5, 3, -7};
+  for (int key : {9, -7, 123, 45, 100}) {
+    a.erase(a.find(key));
+    b.erase(key);
+    EXPECT_TRUE(compare_tree(a, b));
+  }
+  a.erase(a.begin());
+  b.erase(b.begin());
+  EXPECT_TRUE(compare_tree(a, b));
+}
+
+TEST(CompactSetTest, SlotsAreRecycled) {
+  s21::compact_set<int> a;
+  for (int i = 0; i < 100; ++i) a.insert(i);
+  std::size_t arena = a.memory_usage();
+  for (int i = 0; i < 100; i += 2) a.erase(a.find(i));
+  for (int i = 1000; i < 1050; ++i) a.insert(i);
+  EXPECT_EQ(a.memory_usage(), arena);
+  EXPECT_EQ(a.size(), 100);
+}
+
+TEST(CompactSetTest, ReserveKeepsContents) {
+  s21::compact_set<int> a = {5, 3, 8, 1, 4};
+  a.erase(a.find(3));
+  a.reserve(1000);
+  EXPECT_TRUE(compare_tree(a, std::set<int>{1, 4, 5, 8}));
+  a.insert(3);
+  EXPECT_TRUE(compare_tree(a, std::set<int>{1, 3, 4, 5, 8}));
+}
+
+TEST(CompactSetTest, CopyAndMove) {
+  s21::compact_set<std::string> a = {"b", "a", "d", "c"};
+  s21::compact_set<std::string> b(a);
+  std::set<std::string> c = {"a", "b", "c", "d"};
+  EXPECT_TRUE(compare_tree(b, c));
+  s21::compact_set<std::string> d(std::move(a));
+  EXPECT_TRUE(compare_tree(d, c));
+  EXPECT_TRUE(a.empty());
+  a = d;
+  EXPECT_TRUE(compare_tree(a, c));
+  b = std::move(d);
+  EXPECT_TRUE(compare_tree(b, c));
+}
+
+TEST(CompactSetTest, Merge) {
+  s21::compact_set<int> a = {1, 3, 5};
+  s21::compact_set<int> b = {2, 3, 4};
+  a.merge(b);
+  EXPECT_TRUE(compare_tree(a, std::set<int>{1, 2, 3, 4, 5}));
+  EXPECT_TRUE(b.empty());
+}
+
+//  Scribbles over its own storage before giving up
+struct Scribbler {
+  static constexpr int kBad = -1;
+  int value;
+  explicit Scribbler(int v) : value(v) {}
+  Scribbler(const Scribbler &other) : value(0x5ca1ab1e) {
+    if (other.value == kBad) throw std::runtime_error("Scribbler");
+    value = other.value;
+  }
+  bool operator<(const Scribbler &other) const { return value < other.value; }
+};
+
+TEST(CompactSetTest, ThrowingKeyKeepsFreeList) {
+  s21::compact_set<Scribbler> a;
+  for (int i = 0; i < 4; ++i) a.insert(Scribbler(i));
+  a.erase(a.find(Scribbler(1)));
+  const Scribbler bad(Scribbler::kBad);
+  EXPECT_THROW(a.insert(bad), std::runtime_error);
+  EXPECT_EQ(a.size(), 3);
+  std::size_t arena = a.memory_usage();
+  a.insert(Scribbler(7));
+  a.insert(Scribbler(8));
+  EXPECT_EQ(a.size(), 5);
+  EXPECT_EQ(a.memory_usage(), arena);
+  EXPECT_TRUE(a.contains(Scribbler(7)));
+}
+
+TEST(CompactSetTest, NodeIsCompact) {
+  using Tree = s21::CompactTree<std::uint32_t>;
+  EXPECT_EQ(sizeof(Tree::Node), 16);
+}
+
+TEST(CompactSetTest, MatchesStdSet) {
+  s21::compact_set<int> a;
+  std::set<int> b;
+  unsigned seed = 3;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = seed % 5000;
+    if (i % 3 == 0) {
+      a.erase(a.find(key));
+      b.erase(key);
+    } else {
+      EXPECT_EQ(a.insert(key).second, b.insert(key).second);
+    }
+  }
+  EXPECT_TRUE(compare_tree(a, b));
+}
+
+TEST(CompactMapTest, Access) {
+  s21::compact_map<int, std::string> a = {{1, "one"}, {2, "two"}};
+  EXPECT_EQ(a.at(1), "one");
+  EXPECT_THROW(a.at(3), std::out_of_range);
+  a[3] = "three";
+  EXPECT_EQ(a.at(3), "three");
+  EXPECT_TRUE(a.contains(2));
+  EXPECT_FALSE(a.insert(2, "deux").second);
+  EXPECT_FALSE(a.insert_or_assign(2, "deux").second);
+  EXPECT_EQ(a[2], "deux");
+  std::map<int, std::string> b = {{1, "one"}, {2, "deux"}, {3, "three"}};
+  EXPECT_TRUE(compare_tree(a, b));
+}
+
+TEST(CompactMapTest, MovesKeysAndValues) {
+  s21::compact_map<std::string, std::string> a;
+  std::string key(64, 'k');
+  std::string value(64, 'v');
+  EXPECT_TRUE(a.insert(std::move(key), std::move(value)).second);
+  EXPECT_TRUE(key.empty());
+  EXPECT_TRUE(value.empty());
+  std::string other(64, 'o');
+  a[std::move(other)] = "x";
+  EXPECT_TRUE(other.empty());
+  std::string replacement(64, 'r');
+  EXPECT_FALSE(
+      a.insert_or_assign(std::string(64, 'k'), std::move(replacement)).second);
+  EXPECT_TRUE(replacement.empty());
+  EXPECT_EQ(a.at(std::string(64, 'k')), std::string(64, 'r'));
+  std::pair<const std::string, std::string> pair("p", std::string(64, 'p'));
+  EXPECT_TRUE(a.insert(std::move(pair)).second);
+  EXPECT_EQ(a.size(), 3);
+}
@@ -0,0 +1,66 @@
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "../s21_concurrent_map.h"
+#include "gtest/gtest.h"
+
+TEST(ConcurrentMapTest, Basics) {
+  s21::concurrent_map<int, int, 4> a = {{1, 10}, {2, 20}};
+  EXPECT_EQ(a.size(), 2);
+  EXPECT_TRUE(a.upsert(3, 30));
+  EXPECT_FALSE(a.upsert(3, 31));
+  int seen = 0;
+  EXPECT_TRUE(a.visit(3, [&seen](const int &value) { seen = value; }));
+  EXPECT_EQ(seen, 31);
+  EXPECT_FALSE(a.visit(4, [&seen](const int &value) { seen = value; }));
+  EXPECT_TRUE(a.erase(1));
+  EXPECT_FALSE(a.erase(1));
+  EXPECT_FALSE(a.contains(1));
+  EXPECT_TRUE(a.contains(2));
+  a.clear();
+  EXPECT_TRUE(a.empty());
+}
+
+TEST(ConcurrentMapTest, ParallelWriters) {
+  s21::concurrent_map<int, long, 8> a;
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 8; ++t) {
+    writers.emplace_back([&a, t] {
+      for (int i = 0; i < 2000; ++i) {
+        a.upsert_with(
+            i, [] { return 1L; }, [](long &value) { ++value; });
+        if (i % 8 == t) a.upsert(-i - 1, long(t));
+      }
+    });
+  }
+  for (auto &writer : writers) writer.join();
+  EXPECT_EQ(a.size(), 4000);
+  for (int i = 0; i < 2000; ++i) {
+    long value = 0;
+    a.visit(i, [&value](const long &v) { value = v; });
+    EXPECT_EQ(value, 8);
+  }
+}
+
+TEST(ConcurrentMapTest, ForEach) {
+  s21::concurrent_map<int, int, 16> a;
+  std::map<int, int> b;
+  for (int i = 0; i < 1000; ++i) {
+    a.upsert(i * 7, i);
+    b[i * 7] = i;
+  }
+  std::atomic<long> keys{0}, values{0};
+  a.for_each([&](const std::pair<const int, int> &item) {
+    keys += item.first;
+    values += item.second;
+  });
+  long expect_keys = 0, expect_values = 0;
+  for (const auto &item : b) {
+    expect_keys += item.first;
+    expect_values += item.second;
+  }
+  EXPECT_EQ(keys.load(), expect_keys);
+  EXPECT_EQ(values.load(), expect_values);
+}
@@ -0,0 +1,109 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_concurrent_unordered_map.h"
+#include "gtest/gtest.h"
+
+TEST(ConcurrentUnorderedMapTest, Basics) {
+  s21::concurrent_unordered_map<int, std::string> a = {{1, "a"}, {2, "b"}};
+  EXPECT_EQ(a.size(), 2u);
+  EXPECT_TRUE(a.insert(3, "c"));
+  EXPECT_FALSE(a.insert(3, "x"));
+  EXPECT_FALSE(a.upsert(3, "d"));
+  std::string value;
+  EXPECT_TRUE(a.find(3, value));
+  EXPECT_EQ(value, "d");
+  EXPECT_FALSE(a.find(4, value));
+  a.upsert_with(
+      3, [] { return std::string(); },
+      [](std::string &text) { text += "!"; });
+  EXPECT_TRUE(a.visit(3, [](const std::string &text) {
+    EXPECT_EQ(text, "d!");
+  }));
+  EXPECT_TRUE(a.erase(1));
+  EXPECT_FALSE(a.erase(1));
+  EXPECT_FALSE(a.contains(1));
+  for (int i = 0; i < 1000; ++i) a.insert(i + 10, std::to_string(i));
+  EXPECT_EQ(a.size(), 1002u);
+  EXPECT_GE(a.bucket_count(), 1002u);
+  a.clear();
+  EXPECT_TRUE(a.empty());
+}
+
+//  Readers check that a value always matches its key while writers
+//  overwrite, erase and grow the table underneath them
+TEST(ConcurrentUnorderedMapTest, ReadersDuringWritesAndResize) {
+  s21::concurrent_unordered_map<int, long, std::hash<int>,
+                                std::equal_to<int>, 8>
+      a;
+  std::atomic<bool> done{false};
+  std::atomic<long> bad{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&] {
+      unsigned seed = 1;
+      while (!done.load()) {
+        seed = seed * 1103515245 + 12345;
+        int key = int(seed >> 16) % 20000;
+        a.visit(key, [&](const long &value) {
+          if (value % 20000 != key) ++bad;
+        });
+      }
+    });
+  }
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t) {
+    writers.emplace_back([&a, t] {
+      for (int i = t; i < 20000; i += 4) a.upsert(i, long(i));
+      for (int i = t; i < 20000; i += 8) a.erase(i);
+      for (int i = t; i < 20000; i += 4) {
+        a.upsert_with(
+            i, [i] { return long(i); }, [](long &value) { value += 20000; });
+      }
+    });
+  }
+  for (auto &writer : writers) writer.join();
+  done = true;
+  for (auto &reader : readers) reader.join();
+  EXPECT_EQ(bad.load(), 0);
+  EXPECT_EQ(a.size(), 20000u);
+  long bumped = 0;
+  a.for_each([&](const std::pair<const int, long> &item) {
+    if (item.second % 20000 != item.first) ++bad;
+    bumped += item.second >= 20000;
+  });
+  EXPECT_EQ(bad.load(), 0);
+  EXPECT_EQ(bumped, 10000);
+}
+
+namespace {
+struct Counted {
+  static std::atomic<int> alive;
+  int value;
+  explicit Counted(int v) : value(v) { ++alive; }
+  Counted(const Counted &other) : value(other.value) { ++alive; }
+  ~Counted() { --alive; }
+};
+std::atomic<int> Counted::alive{0};
+}  // namespace
+
+//  Tables replaced while a reader was pinned hold copies of every node;
+//  writes after the reader leaves must free them without another resize
+TEST(ConcurrentUnorderedMapTest, ErasesReclaimRetiredTables) {
+  s21::concurrent_unordered_map<int, Counted, s21::hash<int>,
+                                std::equal_to<int>, 1>
+      a;
+  {
+    s21::EpochGuard reader;
+    for (int i = 0; i < 1000; ++i) a.insert(i, Counted(i));
+  }
+  EXPECT_GT(Counted::alive, 1000);
+  //  One retire batch, no resize
+  for (int i = 0; i < 64; ++i) EXPECT_TRUE(a.erase(i));
+  EXPECT_EQ(Counted::alive, 1000 - 64);
+  a.clear();
+  a.insert(0, Counted(0));
+  EXPECT_EQ(Counted::alive, 1);
+}
@@ -0,0 +1,117 @@
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../s21_disk_btree_map.h"
+#include "gtest/gtest.h"
+
+namespace {
+//  Removes the backing file when the test ends
+class TempFile {
+ public:
+  TempFile()
+      : path_(testing::TempDir() + "s21_btree_" + std::to_string(::getpid()) +
+              "_" + testing::UnitTest::GetInstance()->current_test_info()->name()) {
+    ::unlink(path_.c_str());
+  }
+  ~TempFile() { ::unlink(path_.c_str()); }
+  const std::string &path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+}  // namespace
+
+TEST(DiskBtreeMapTest, MatchesStdMap) {
+  TempFile file;
+  //  Small cache and large values, so pages split and get evicted often
+  using Map = s21::disk_btree_map<std::int64_t, std::array<char, 200>>;
+  Map map(file.path(), 8);
+  std::map<std::int64_t, std::array<char, 200>> expected;
+  std::mt19937 rng(7);
+  for (int i = 0; i < 20000; ++i) {
+    std::int64_t key = rng() % 5000;
+    std::array<char, 200> value{};
+    value[0] = char(i);
+    if (rng() % 4 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else if (rng() % 2 == 0) {
+      map.insert_or_assign(key, value);
+      expected[key] = value;
+    } else {
+      EXPECT_EQ(map.insert(key, value).second,
+                expected.insert({key, value}).second);
+    }
+  }
+  ASSERT_EQ(map.size(), expected.size());
+  EXPECT_GT(map.height(), 2u);
+  auto want = expected.begin();
+  for (auto it = map.begin(); it != map.end(); ++it, ++want) {
+    ASSERT_EQ(it->first, want->first);
+    ASSERT_EQ(it->second[0], want->second[0]);
+  }
+  EXPECT_EQ(want, expected.end());
+  for (std::int64_t key = -1; key <= 5000; ++key) {
+    ASSERT_EQ(map.contains(key), expected.count(key) == 1);
+  }
+  EXPECT_THROW(map.at(-1), std::out_of_range);
+}
+
+TEST(DiskBtreeMapTest, ReopenKeepsEntries) {
+  TempFile file;
+  {
+    s21::disk_btree_map<int, double, 8192> map(file.path(), 16);
+    for (int i = 0; i < 10000; ++i) map.insert(i * 3, i * 0.5);
+    auto found = map.find(300);
+    ASSERT_NE(found, map.end());
+    EXPECT_EQ(found->second, 50.0);
+  }
+  s21::disk_btree_map<int, double, 8192> map(file.path(), 16);
+  EXPECT_EQ(map.size(), 10000u);
+  EXPECT_EQ(map.at(2997), 499.5);
+  EXPECT_EQ(map.find(2998), map.end());
+  auto it = map.lower_bound(2998);
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ(it->first, 3000);
+  EXPECT_THROW((s21::disk_btree_map<int, double, 4096>(file.path())),
+               std::runtime_error);
+}
+
+TEST(DiskBtreeMapTest, BulkLoadAndScan) {
+  TempFile file;
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> items;
+  for (std::uint64_t i = 0; i < 200000; ++i) items.emplace_back(i * 2, i);
+  s21::disk_btree_map<std::uint64_t, std::uint64_t> map(file.path(), 8);
+  map.bulk_load(items.begin(), items.end());
+  EXPECT_EQ(map.size(), items.size());
+  EXPECT_EQ(map.height(), 3u);
+  std::uint64_t expected = 0;
+  for (const auto &item : map) {
+    ASSERT_EQ(item.first, expected * 2);
+    ++expected;
+  }
+  EXPECT_EQ(expected, items.size());
+  EXPECT_EQ(map.at(123456), 61728u);
+  EXPECT_TRUE(map.insert(7, 7).second);
+  EXPECT_EQ(map.lower_bound(5)->first, 6u);
+  EXPECT_EQ(map.lower_bound(7)->second, 7u);
+  EXPECT_THROW(map.bulk_load(items.begin(), items.end()), std::logic_error);
+}
+
+TEST(DiskBtreeMapTest, BulkLoadRejectsUnsorted) {
+  TempFile file;
+  std::vector<std::pair<int, int>> items = {{1, 1}, {3, 3}, {2, 2}};
+  s21::disk_btree_map<int, int> map(file.path());
+  EXPECT_THROW(map.bulk_load(items.begin(), items.end()),
+               std::invalid_argument);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_TRUE(map.insert(2, 2).second);
+  EXPECT_EQ(map.at(2), 2);
+}
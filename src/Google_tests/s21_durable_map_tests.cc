@@ -0,0 +1,140 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_durable_map.h"
+#include "gtest/gtest.h"
+
+namespace {
+//  Removes the log and snapshot when the test ends
+class TempPath {
+ public:
+  TempPath()
+      : path_(testing::TempDir() + "s21_durable_" +
+              std::to_string(::getpid()) + "_" +
+              testing::UnitTest::GetInstance()->current_test_info()->name()) {
+    Remove();
+  }
+  ~TempPath() { Remove(); }
+  const std::string &path() const { return path_; }
+
+ private:
+  void Remove() {
+    ::unlink((path_ + ".log").c_str());
+    ::unlink((path_ + ".snap").c_str());
+  }
+  std::string path_;
+};
+
+off_t FileSize(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  off_t size = ::lseek(fd, 0, SEEK_END);
+  ::close(fd);
+  return size;
+}
+}  // namespace
+
+TEST(DurableMapTest, RecoversFromLog) {
+  TempPath file;
+  std::map<int, std::string> expected;
+  {
+    s21::durable_map<int, std::string> map(file.path());
+    std::mt19937 rng(3);
+    for (int i = 0; i < 500; ++i) {
+      int key = rng() % 100;
+      if (rng() % 3 == 0) {
+        EXPECT_EQ(map.erase(key), expected.erase(key));
+      } else {
+        std::string value(rng() % 20, char('a' + i % 26));
+        EXPECT_EQ(map.insert_or_assign(key, value),
+                  expected.count(key) == 0);
+        expected[key] = value;
+      }
+    }
+    EXPECT_FALSE(map.insert(expected.begin()->first, "x"));
+  }
+  s21::durable_map<int, std::string> map(file.path());
+  ASSERT_EQ(map.size(), expected.size());
+  for (const auto &item : expected) {
+    std::string value;
+    ASSERT_TRUE(map.find(item.first, value));
+    EXPECT_EQ(value, item.second);
+  }
+  EXPECT_FALSE(map.contains(1000));
+  EXPECT_THROW(map.at(1000), std::out_of_range);
+}
+
+TEST(DurableMapTest, SnapshotPlusLogTail) {
+  TempPath file;
+  s21::durable_options options;
+  options.sync = s21::durable_sync::batched;
+  options.snapshot_records = 1000;
+  {
+    s21::durable_map<long, long> map(file.path(), options);
+    for (long i = 0; i < 2500; ++i) map.insert(i, i * i);
+    for (long i = 0; i < 2500; i += 2) map.erase(i);
+    //  3750 records: three snapshots, 750 records in the log
+    EXPECT_LT(FileSize(file.path() + ".log"), 1000 * 40);
+    map.commit();
+  }
+  s21::durable_map<long, long> map(file.path(), options);
+  EXPECT_EQ(map.size(), 1250u);
+  EXPECT_EQ(map.at(2499), 2499L * 2499);
+  EXPECT_FALSE(map.contains(2498));
+  long sum = map.read([](const s21::map<long, long> &items) {
+    long total = 0;
+    for (const auto &item : items) total += item.first;
+    return total;
+  });
+  EXPECT_EQ(sum, 1250L * 1250);
+  bool lookups = map.read([](const s21::map<long, long> &items) {
+    return items.size() == 1250u && !items.empty() &&
+           items.at(7) == 49 && items.contains(9) && !items.contains(8) &&
+           items.find(11)->second == 121 && items.find(12) == items.end();
+  });
+  EXPECT_TRUE(lookups);
+  map.compact();
+  EXPECT_EQ(FileSize(file.path() + ".log"), 0);
+}
+
+TEST(DurableMapTest, TornTailIsDropped) {
+  TempPath file;
+  {
+    s21::durable_map<int, int> map(file.path());
+    for (int i = 0; i < 10; ++i) map.insert(i, i);
+  }
+  off_t size = FileSize(file.path() + ".log");
+  ASSERT_EQ(::truncate((file.path() + ".log").c_str(), size - 3), 0);
+  {
+    s21::durable_map<int, int> map(file.path());
+    EXPECT_EQ(map.size(), 9u);
+    EXPECT_FALSE(map.contains(9));
+    map.insert(100, 100);
+  }
+  s21::durable_map<int, int> map(file.path());
+  EXPECT_EQ(map.size(), 10u);
+  EXPECT_EQ(map.at(100), 100);
+}
+
+TEST(DurableMapTest, GroupCommitFromManyThreads) {
+  TempPath file;
+  {
+    s21::durable_map<int, int> map(file.path());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&map, t] {
+        for (int i = 0; i < 50; ++i) map.insert(t * 1000 + i, i);
+      });
+    }
+    for (auto &thread : threads) thread.join();
+    EXPECT_EQ(map.size(), 200u);
+  }
+  s21::durable_map<int, int> map(file.path());
+  EXPECT_EQ(map.size(), 200u);
+  EXPECT_EQ(map.at(3049), 49);
+}
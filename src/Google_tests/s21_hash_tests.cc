@@ -0,0 +1,88 @@
+#include <bitset>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../s21_hash.h"
+#include "../s21_unordered_map.h"
+#include "gtest/gtest.h"
+
+TEST(HashTest, LongInputSimdMatchesScalar) {
+  std::mt19937_64 rng(1);
+  std::vector<unsigned char> bytes(5000);
+  for (auto &byte : bytes) byte = static_cast<unsigned char>(rng());
+  for (std::size_t len = s21::ByteHasher::kLongInput + 1; len < bytes.size();
+       len += 7) {
+    EXPECT_EQ(s21::ByteHasher::Long<true>(bytes.data(), len, 9),
+              s21::ByteHasher::Long<false>(bytes.data(), len, 9))
+        << len;
+  }
+}
+
+TEST(HashTest, EveryLengthAndSeedDiffers) {
+  std::string text(700, 'a');
+  std::set<std::uint64_t> seen;
+  for (std::size_t len = 0; len <= text.size(); ++len) {
+    seen.insert(s21::hash_bytes(text.data(), len));
+    seen.insert(s21::hash_bytes(text.data(), len, 1));
+  }
+  EXPECT_EQ(seen.size(), 2 * (text.size() + 1));
+}
+
+TEST(HashTest, StringTypesAgree) {
+  std::string text = "the quick brown fox";
+  s21::hash<std::string> hash;
+  EXPECT_EQ(hash(text), s21::hash<std::string_view>()(text));
+  EXPECT_EQ(hash(text), hash("the quick brown fox"));
+  EXPECT_NE(hash(text), hash("the quick brown fix"));
+  EXPECT_TRUE(s21::IsAvalanching<s21::hash<std::string>>::value);
+  EXPECT_FALSE(s21::IsAvalanching<std::hash<std::string>>::value);
+}
+
+TEST(HashTest, ScalarsAreMixed) {
+  s21::hash<int> hash;
+  EXPECT_NE(hash(1), 1u);
+  //  Consecutive keys spread over the low bits
+  std::set<std::size_t> buckets;
+  for (int i = 0; i < 64; ++i) buckets.insert(hash(i) & 1023);
+  EXPECT_GT(buckets.size(), 55u);
+  EXPECT_EQ(s21::hash<double>()(0.0), s21::hash<double>()(-0.0));
+  EXPECT_NE(s21::hash<double>()(1.0), s21::hash<double>()(2.0));
+  EXPECT_NE(s21::hash<long double>()(1.0L), s21::hash<long double>()(2.0L));
+  int value = 0;
+  EXPECT_EQ(s21::hash<int *>()(&value),
+            s21::hash_mix(reinterpret_cast<std::uintptr_t>(&value)));
+}
+
+TEST(HashTest, MixAvalanches) {
+  //  Flipping one input bit flips each output bit about half the time
+  std::mt19937_64 rng(5);
+  constexpr int kSamples = 4000;
+  for (int bit = 0; bit < 64; ++bit) {
+    std::vector<int> flips(64);
+    for (int i = 0; i < kSamples; ++i) {
+      std::uint64_t x = rng();
+      std::bitset<64> diff(s21::hash_mix(x) ^
+                           s21::hash_mix(x ^ (1ull << bit)));
+      for (int out = 0; out < 64; ++out) flips[out] += diff[out];
+    }
+    for (int out = 0; out < 64; ++out) {
+      EXPECT_NEAR(flips[out], kSamples / 2, kSamples / 10) << bit << out;
+    }
+  }
+}
+
+TEST(HashTest, TransparentLookupInUnorderedMap) {
+  s21::unordered_map<std::string, int, s21::hash<std::string>,
+                     std::equal_to<>>
+      map;
+  map["alpha"] = 1;
+  map["beta"] = 2;
+  std::string_view key = "beta";
+  EXPECT_NE(map.find(key), map.end());
+  EXPECT_EQ(map.find(key)->second, 2);
+  EXPECT_EQ(map.find("gamma"), map.end());
+}
@@ -0,0 +1,106 @@
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../s21_interval_map.h"
+#include "gtest/gtest.h"
+
+namespace {
+using Segments = std::vector<std::tuple<int, int, char>>;
+
+Segments Dump(const s21::interval_map<int, char> &map) {
+  Segments result;
+  for (const auto &item : map) {
+    result.emplace_back(item.first, item.second.end, item.second.value);
+  }
+  return result;
+}
+
+template <class Map, class = void>
+struct HasRawInsert : std::false_type {};
+template <class Map>
+struct HasRawInsert<Map, std::void_t<decltype(std::declval<Map &>().insert(
+                             std::declval<typename Map::value_type>()))>>
+    : std::true_type {};
+}  // namespace
+
+TEST(IntervalMapTest, SplitAndCoalesce) {
+  s21::interval_map<int, char> a;
+  a.assign(0, 10, 'a');
+  a.assign(3, 5, 'b');
+  EXPECT_EQ(Dump(a), Segments({{0, 3, 'a'}, {3, 5, 'b'}, {5, 10, 'a'}}));
+  EXPECT_EQ(a.at(4), 'b');
+  EXPECT_EQ(a.at(5), 'a');
+  EXPECT_FALSE(a.contains(10));
+  EXPECT_FALSE(a.contains(-1));
+  a.assign(3, 5, 'a');
+  EXPECT_EQ(Dump(a), Segments({{0, 10, 'a'}}));
+  a.assign(10, 12, 'a');
+  a.assign(-2, 0, 'a');
+  EXPECT_EQ(Dump(a), Segments({{-2, 12, 'a'}}));
+  a.erase(4, 6);
+  EXPECT_EQ(Dump(a), Segments({{-2, 4, 'a'}, {6, 12, 'a'}}));
+  a.assign(2, 8, 'c');
+  EXPECT_EQ(Dump(a), Segments({{-2, 2, 'a'}, {2, 8, 'c'}, {8, 12, 'a'}}));
+  a.assign(-5, 20, 'd');
+  EXPECT_EQ(Dump(a), Segments({{-5, 20, 'd'}}));
+  a.assign(5, 5, 'x');
+  EXPECT_EQ(a.size(), 1);
+  EXPECT_THROW(a.at(20), std::out_of_range);
+}
+
+TEST(IntervalMapTest, MatchesPointModel) {
+  s21::interval_map<int, char> a;
+  std::map<int, char> model;
+  unsigned seed = 11;
+  auto next = [&seed] { return (seed = seed * 1103515245 + 12345) >> 16; };
+  for (int round = 0; round < 3000; ++round) {
+    int lo = next() % 400, hi = lo + next() % 40;
+    if (next() % 5 == 0) {
+      a.erase(lo, hi);
+      for (int k = lo; k < hi; ++k) model.erase(k);
+    } else {
+      char value = 'a' + next() % 3;
+      a.assign(lo, hi, value);
+      for (int k = lo; k < hi; ++k) model[k] = value;
+    }
+  }
+  for (int k = -1; k < 450; ++k) {
+    const char *value = a.find(k);
+    auto it = model.find(k);
+    ASSERT_EQ(value != nullptr, it != model.end()) << k;
+    if (value) {
+      EXPECT_EQ(*value, it->second) << k;
+    }
+  }
+  //  Coalesced: neighbours that touch never share a value
+  Segments segments = Dump(a);
+  for (size_t i = 1; i < segments.size(); ++i) {
+    EXPECT_TRUE(std::get<0>(segments[i]) > std::get<1>(segments[i - 1]) ||
+                std::get<2>(segments[i]) != std::get<2>(segments[i - 1]));
+  }
+}
+
+TEST(IntervalMapTest, SortedAssignsStayShallow) {
+  s21::interval_map<int, int> a;
+  for (int i = 0; i < 100000; ++i) a.assign(2 * i, 2 * i + 1, i);
+  EXPECT_EQ(a.size(), 100000);
+  EXPECT_LT(a.height(), 64);
+  EXPECT_EQ(a.at(2 * 777), 777);
+  EXPECT_FALSE(a.contains(2 * 777 + 1));
+}
+
+TEST(IntervalMapTest, TreeInsertsAreHidden) {
+  //  A raw tree insert would skip cutting overlapping ranges
+  EXPECT_FALSE((HasRawInsert<s21::interval_map<int, char>>::value));
+  s21::interval_map<int, char> a;
+  a.assign(0, 4, 'a');
+  EXPECT_FALSE(a.empty());
+  a.clear();
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.begin(), a.end());
+  a.assign(1, 2, 'b');
+  EXPECT_EQ(Dump(a), Segments({{1, 2, 'b'}}));
+}
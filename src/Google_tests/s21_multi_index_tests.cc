@@ -0,0 +1,82 @@
+#include <string>
+#include <vector>
+
+#include "../s21_multi_index.h"
+#include "gtest/gtest.h"
+
+namespace {
+struct Task {
+  int id;
+  std::string name;
+  long deadline;
+};
+
+using Tasks = s21::multi_index<
+    Task, s21::ordered_unique<s21::member<Task, int, &Task::id>>,
+    s21::ordered_unique<s21::member<Task, std::string, &Task::name>>,
+    s21::ordered_non_unique<s21::member<Task, long, &Task::deadline>>>;
+
+std::vector<int> Ids(const Tasks::view_type<2> &view) {
+  std::vector<int> ids;
+  for (const Task &task : view) ids.push_back(task.id);
+  return ids;
+}
+}  // namespace
+
+TEST(MultiIndexTest, InsertAndLookup) {
+  Tasks a = {{3, "c", 30}, {1, "a", 10}, {2, "b", 10}};
+  EXPECT_EQ(a.size(), 3);
+  EXPECT_EQ(a.get<0>().find(2)->name, "b");
+  EXPECT_EQ(a.get<1>().find("c")->id, 3);
+  EXPECT_EQ(a.get<2>().count(10), 2);
+  EXPECT_TRUE(a.get<0>().find(4) == a.get<0>().end());
+  EXPECT_EQ(a.get<1>().begin()->name, "a");
+  EXPECT_EQ(a.get<2>().lower_bound(11)->id, 3);
+}
+
+TEST(MultiIndexTest, UniqueIndexesRejectAtomically) {
+  Tasks a = {{1, "a", 10}};
+  auto result = a.insert({2, "a", 20});
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first->id, 1);
+  EXPECT_EQ(a.size(), 1);
+  EXPECT_EQ(a.get<0>().size(), 1);
+  EXPECT_EQ(a.get<2>().size(), 1);
+  EXPECT_FALSE(a.get<0>().contains(2));
+  EXPECT_TRUE(a.emplace(Task{2, "b", 20}).second);
+}
+
+TEST(MultiIndexTest, ModifyResortsEveryIndex) {
+  Tasks a = {{1, "a", 10}, {2, "b", 20}, {3, "c", 30}};
+  const Task *task = a.get<0>().find(1).operator->();
+  EXPECT_TRUE(a.modify(task, [](Task &t) {
+    t.deadline = 40;
+    t.name = "z";
+  }));
+  EXPECT_EQ(Ids(a.get<2>()), std::vector<int>({2, 3, 1}));
+  EXPECT_EQ(a.get<1>().find("z")->id, 1);
+  EXPECT_FALSE(a.get<1>().contains("a"));
+  //  Renaming onto an existing name is refused and changes nothing
+  EXPECT_FALSE(a.modify(task, [](Task &t) {
+    t.name = "b";
+    t.deadline = 0;
+  }));
+  EXPECT_EQ(task->name, "z");
+  EXPECT_EQ(Ids(a.get<2>()), std::vector<int>({2, 3, 1}));
+  //  Replacing an element with itself is fine
+  EXPECT_TRUE(a.replace(task, *task));
+}
+
+TEST(MultiIndexTest, EraseAndClear) {
+  Tasks a = {{1, "a", 10}, {2, "b", 10}, {3, "c", 10}};
+  a.erase(&*a.get<1>().find("b"));
+  EXPECT_EQ(a.size(), 2);
+  EXPECT_EQ(a.get<2>().count(10), 2);
+  EXPECT_FALSE(a.get<0>().contains(2));
+  Tasks b = std::move(a);
+  EXPECT_EQ(b.size(), 2);
+  EXPECT_TRUE(a.empty());
+  b.clear();
+  EXPECT_TRUE(b.empty());
+  EXPECT_TRUE(b.get<2>().empty());
+}
@@ -0,0 +1,94 @@
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../s21_multimap.h"
+#include "gtest/gtest.h"
+
+TEST(MultimapTest, EqualKeysKeepInsertionOrder) {
+  s21::multimap<int, std::string> map = {{2, "b"}, {1, "a"}, {2, "c"}};
+  map.insert(2, "d");
+  map.insert(std::make_pair(0, std::string("z")));
+  EXPECT_EQ(map.size(), 5u);
+  EXPECT_EQ(map.count(2), 3u);
+  EXPECT_EQ(map.count(3), 0u);
+  std::vector<std::string> values;
+  for (auto range = map.equal_range(2); range.first != range.second;
+       ++range.first) {
+    values.push_back(range.first->second);
+  }
+  EXPECT_EQ(values, std::vector<std::string>({"b", "c", "d"}));
+  EXPECT_EQ(map.find(2)->second, "b");
+  EXPECT_EQ(map.find(5), map.end());
+  EXPECT_EQ(map.lower_bound(1)->second, "a");
+  EXPECT_EQ(map.upper_bound(1)->second, "b");
+  EXPECT_EQ(map.erase(2), 3u);
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.size(), 2u);
+  s21::multimap<int, std::string> copy(map);
+  EXPECT_EQ(copy.begin()->second, "z");
+}
+
+TEST(MultimapTest, RunMultimapMatchesStdMultimap) {
+  s21::run_multimap<int, std::string> runs;
+  std::multimap<int, std::string> expected;
+  std::mt19937 rng(5);
+  for (int i = 0; i < 4000; ++i) {
+    int key = rng() % 150;
+    if (rng() % 10 == 0) {
+      EXPECT_EQ(runs.erase(key), expected.erase(key));
+    } else {
+      std::string value = std::to_string(i);
+      runs.insert(key, value);
+      expected.emplace(key, value);
+    }
+  }
+  ASSERT_EQ(runs.size(), expected.size());
+  std::size_t keys = 0;
+  auto want = expected.begin();
+  for (const auto &item : runs) {
+    ++keys;
+    ASSERT_EQ(runs.count(item.first), expected.count(item.first));
+    for (const std::string &value : item.second) {
+      ASSERT_EQ(want->first, item.first);
+      ASSERT_EQ(want->second, value);
+      ++want;
+    }
+  }
+  EXPECT_EQ(keys, runs.key_count());
+  EXPECT_EQ(want, expected.end());
+}
+
+TEST(MultimapTest, RunsAreContiguous) {
+  s21::run_multimap<int, long> runs = {{1, 10}, {2, 20}, {1, 11}};
+  for (long i = 12; i < 100; ++i) runs.emplace(1, i);
+  auto range = runs.equal_range(1);
+  ASSERT_EQ(range.second - range.first, 90);
+  for (long i = 0; i < 90; ++i) EXPECT_EQ(range.first[i], 10 + i);
+  EXPECT_EQ(runs.count(1), 90u);
+  EXPECT_EQ(runs.equal_range(3).first, runs.equal_range(3).second);
+  s21::run_multimap<int, long> copy(runs);
+  runs.erase(runs.find(2), runs.equal_range(2).first);
+  EXPECT_FALSE(runs.contains(2));
+  EXPECT_EQ(runs.size(), 90u);
+  EXPECT_EQ(copy.size(), 91u);
+  EXPECT_EQ(copy.equal_range(2).first[0], 20);
+  runs.erase(runs.find(1), runs.equal_range(1).first + 5);
+  EXPECT_EQ(runs.equal_range(1).first[5], 16);
+  runs.clear();
+  EXPECT_TRUE(runs.empty());
+}
+
+TEST(MultimapTest, InsertFromOwnRunWhileGrowing) {
+  s21::run_multimap<int, std::string> runs;
+  runs.insert(1, std::string(40, 'a'));
+  //  Every other insert finds the run full and moves it
+  for (int i = 0; i < 8; ++i) runs.insert(1, *runs.equal_range(1).first);
+  runs.emplace(1, runs.equal_range(1).first[4]);
+  auto range = runs.equal_range(1);
+  ASSERT_EQ(range.second - range.first, 10);
+  for (auto it = range.first; it != range.second; ++it) {
+    EXPECT_EQ(*it, std::string(40, 'a'));
+  }
+}
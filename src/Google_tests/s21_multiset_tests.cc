@@ -47,6 +47,7 @@ TEST(MultisetTests, Find) {
   auto it = a.find("aaa");
   ASSERT_EQ("aaa", *it);
   auto it2 = a.find("b");
+  ASSERT_TRUE(it2 == a.end());
 }
 
 TEST(MultisetTests, CopyConstructor) {
@@ -100,6 +101,9 @@ TEST(MultisetTests, IteratorInsert) {
   auto pair2 = a.insert("ccc");
   auto pair3 = a.insert("eee");
   ASSERT_EQ("aaa", *pair);
+  ASSERT_EQ("bbb", *pair1);
+  ASSERT_EQ("ccc", *pair2);
+  ASSERT_EQ("eee", *pair3);
   ASSERT_EQ(false, a.contains("hhh"));
   ASSERT_EQ(true, a.contains("bbb"));
   ASSERT_EQ(true, a.contains("eee"));
@@ -518,5 +522,51 @@ TEST(MultisetTests, EqualRange) {
   EXPECT_EQ(*a.equal_range(5).first, *b.equal_range(5).first);
 }
 
+TEST(MultisetTests, InsertMovesKeys) {
+  s21::multiset<std::string> a;
+  std::string key(64, 'x');
+  a.insert(std::move(key));
+  EXPECT_TRUE(key.empty());
+  auto results = a.insert_many(std::string(64, 'x'), std::string(64, 'y'));
+  EXPECT_EQ(results.size(), 2);
+  EXPECT_EQ(*a.emplace(64, 'x'), std::string(64, 'x'));
+  EXPECT_EQ(a.size(), 4);
+}
+
+TEST(MultisetTests, MergeKeepsDuplicates) {
+  s21::multiset<int> a = {1, 3, 3};
+  s21::multiset<int> b = {3, 2};
+  a.merge(b);
+  std::multiset<int> c = {1, 2, 3, 3, 3};
+  EXPECT_TRUE(compare_multiset(a, c));
+  EXPECT_EQ(a.size(), 5);
+  EXPECT_TRUE(b.empty());
+}
+
+TEST(MultisetTests, HintedInsert) {
+  s21::multiset<int> a = {1, 3};
+  auto three = a.find(3);
+  auto it = a.insert(three, 3);
+  ++it;
+  EXPECT_TRUE(it == three);
+  a.insert(a.end(), 3);
+  a.emplace_hint(a.begin(), 0);
+  std::multiset<int> b = {0, 1, 3, 3, 3};
+  EXPECT_TRUE(compare_multiset(a, b));
+}
+
 }  // namespace tests
 }  // namespace s21Multiset
+
+TEST(MultisetTest, EraseExactDuplicate) {
+  s21::multiset<int> a = {2, 1, 2, 3, 2};
+  auto first = a.find(2);
+  auto second = first;
+  ++second;
+  const int *kept = &*second;
+  a.erase(first);
+  EXPECT_EQ(a.count(2), 2);
+  EXPECT_EQ(&*a.find(2), kept);
+  EXPECT_EQ(a.front(), 1);
+  EXPECT_EQ(a.back(), 3);
+}
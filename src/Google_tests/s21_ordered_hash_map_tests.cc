@@ -0,0 +1,140 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../s21_ordered_hash_map.h"
+#include "gtest/gtest.h"
+
+namespace {
+template <class Map>
+std::vector<std::pair<int, std::string>> Items(const Map &map) {
+  return std::vector<std::pair<int, std::string>>(map.begin(), map.end());
+}
+
+//  Counts live values; copying the one tagged `fragile` throws. It has
+//  no move, so a resize copies every entry it keeps.
+struct Fragile {
+  static inline int live = 0;
+  static inline int fragile = -1;
+  int tag = -1;
+  Fragile() { ++live; }
+  explicit Fragile(int t) : tag(t) { ++live; }
+  Fragile(const Fragile &other) : tag(other.tag) {
+    if (tag >= 0 && tag == fragile) throw std::runtime_error("Fragile");
+    ++live;
+  }
+  ~Fragile() { --live; }
+};
+
+template <class Map>
+std::vector<int> Keys(const Map &map) {
+  std::vector<int> keys;
+  for (const auto &item : map) keys.push_back(item.first);
+  return keys;
+}
+}  // namespace
+
+TEST(OrderedHashMapTest, KeepsInsertionOrder) {
+  s21::ordered_hash_map<int, std::string> map = {{3, "c"}, {1, "a"}};
+  map[2] = "b";
+  EXPECT_FALSE(map.insert(3, "x").second);
+  EXPECT_FALSE(map.insert_or_assign(1, "A").second);
+  EXPECT_TRUE(map.emplace(0, "z").second);
+  using Items = std::vector<std::pair<int, std::string>>;
+  EXPECT_EQ(::Items(map), Items({{3, "c"}, {1, "A"}, {2, "b"}, {0, "z"}}));
+  EXPECT_EQ(map.at(2), "b");
+  EXPECT_THROW(map.at(7), std::out_of_range);
+  EXPECT_EQ(map.erase(1), 1u);
+  auto next = map.erase(map.find(2));
+  EXPECT_EQ(next->first, 0);
+  map[1] = "again";
+  EXPECT_EQ(::Items(map), Items({{3, "c"}, {0, "z"}, {1, "again"}}));
+  s21::ordered_hash_map<int, std::string> copy(map);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(::Items(copy), Items({{3, "c"}, {0, "z"}, {1, "again"}}));
+}
+
+TEST(OrderedHashMapTest, MatchesReferenceUnderChurn) {
+  s21::ordered_hash_map<int, std::string> map;
+  std::vector<std::pair<int, std::string>> expected;
+  std::mt19937 rng(3);
+  for (int i = 0; i < 20000; ++i) {
+    int key = rng() % 1500;
+    auto it = expected.begin();
+    while (it != expected.end() && it->first != key) ++it;
+    if (rng() % 3 == 0) {
+      ASSERT_EQ(map.erase(key), it != expected.end() ? 1u : 0u);
+      if (it != expected.end()) expected.erase(it);
+    } else {
+      map.insert_or_assign(key, std::to_string(i));
+      if (it == expected.end()) {
+        expected.emplace_back(key, std::to_string(i));
+      } else {
+        it->second = std::to_string(i);
+      }
+    }
+  }
+  ASSERT_EQ(map.size(), expected.size());
+  EXPECT_EQ(Items(map), expected);
+  EXPECT_LE(map.size() * 3, map.bucket_count() * 2);
+}
+
+TEST(OrderedHashMapTest, EmplaceFromOwnValueAcrossResize) {
+  //  Each resize moves the entry the argument refers to
+  s21::ordered_hash_map<int, std::string> map;
+  map.try_emplace(0, 40, 'x');
+  for (int i = 1; i < 1000; ++i) {
+    if (i % 3 == 0) map.erase(i - 3);
+    map.try_emplace(i, map.at(i - 1));
+    map.insert(std::make_pair(-i, map.at(i)));
+    ASSERT_EQ(map.at(i), std::string(40, 'x'));
+  }
+  EXPECT_EQ(map.at(-999), std::string(40, 'x'));
+  EXPECT_EQ(map.begin()->first, 1);
+}
+
+TEST(OrderedHashMapTest, ThrowingCopyKeepsOrderAndHoles) {
+  Fragile::live = 0;
+  Fragile::fragile = -1;
+  {
+    using FragileMap = s21::ordered_hash_map<int, Fragile>;
+    FragileMap map;
+    for (int i = 0; i < 6; ++i) map.try_emplace(i, i);
+    map.erase(1);
+    map.erase(4);
+    std::vector<int> keys = Keys(map);
+    //  The resize that closes the holes fails on an entry past the first
+    Fragile::fragile = 3;
+    int next = 6;
+    for (;; ++next) {
+      try {
+        map.try_emplace(next, -1);
+      } catch (const std::runtime_error &) {
+        break;
+      }
+      keys.push_back(next);
+    }
+    EXPECT_EQ(Keys(map), keys);
+    EXPECT_FALSE(map.contains(next));
+    EXPECT_EQ(Fragile::live, int(map.size()));
+    EXPECT_THROW(FragileMap copy(map), std::runtime_error);
+    EXPECT_EQ(Fragile::live, int(map.size()));
+    Fragile::fragile = -1;
+    map.try_emplace(next, -1);
+    keys.push_back(next);
+    EXPECT_EQ(Keys(map), keys);
+
+    using Entry = std::pair<const int, Fragile>;
+    std::initializer_list<Entry> items = {Entry(0, Fragile(0)),
+                                          Entry(1, Fragile(1)),
+                                          Entry(2, Fragile(2))};
+    Fragile::fragile = 1;
+    EXPECT_THROW(FragileMap list(items), std::runtime_error);
+    EXPECT_EQ(Fragile::live, int(map.size() + items.size()));
+    Fragile::fragile = -1;
+  }
+  EXPECT_EQ(Fragile::live, 0);
+}
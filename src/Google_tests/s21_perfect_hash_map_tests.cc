@@ -0,0 +1,160 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../s21_perfect_hash_map.h"
+#include "gtest/gtest.h"
+
+namespace {
+using Map = s21::perfect_hash_map<std::uint64_t, std::uint32_t>;
+
+std::vector<std::pair<std::uint64_t, std::uint32_t>> Items(std::uint32_t n) {
+  std::vector<std::pair<std::uint64_t, std::uint32_t>> items;
+  for (std::uint32_t i = 0; i < n; ++i) {
+    items.emplace_back(std::uint64_t(i) * 0x9E3779B97F4A7C15ull, i);
+  }
+  return items;
+}
+}  // namespace
+
+TEST(PerfectHashMapTest, FindsEveryKeyAndRejectsOthers) {
+  auto items = Items(200000);
+  Map map(items.begin(), items.end(), 2.0, 4);
+  ASSERT_EQ(map.size(), items.size());
+  for (const auto &item : items) {
+    const std::uint32_t *value = map.find(item.first);
+    ASSERT_NE(value, nullptr);
+    ASSERT_EQ(*value, item.second);
+  }
+  for (std::uint64_t key = 1; key < 1000; ++key) {
+    EXPECT_FALSE(map.contains(key));
+  }
+  EXPECT_THROW(map.at(1), std::out_of_range);
+  EXPECT_LT(map.bits_per_key(), 5.0);
+  std::uint64_t sum = 0;
+  for (const auto &entry : map) sum += entry.second;
+  EXPECT_EQ(sum, std::uint64_t(199999) * 200000 / 2);
+}
+
+TEST(PerfectHashMapTest, SmallerGammaUsesFewerBits) {
+  auto items = Items(100000);
+  Map tight(items.begin(), items.end(), 1.0);
+  EXPECT_LT(tight.bits_per_key(), 3.8);
+  EXPECT_EQ(tight.at(items[777].first), 777u);
+}
+
+TEST(PerfectHashMapTest, SaveAndMapBack) {
+  auto items = Items(50000);
+  std::string path = testing::TempDir() + "s21_phm_" +
+                     std::to_string(::getpid());
+  {
+    Map map(items.begin(), items.end());
+    map.save(path);
+  }
+  Map loaded = Map::load(path);
+  ::unlink(path.c_str());
+  ASSERT_EQ(loaded.size(), items.size());
+  for (const auto &item : items) ASSERT_EQ(loaded.at(item.first), item.second);
+  Map moved = std::move(loaded);
+  EXPECT_TRUE(loaded.empty());
+  EXPECT_TRUE(moved.contains(items[3].first));
+  EXPECT_THROW(Map::load(path), std::system_error);
+}
+
+TEST(PerfectHashMapTest, EdgeCases) {
+  std::vector<std::pair<int, int>> none;
+  s21::perfect_hash_map<int, int> empty(none.begin(), none.end());
+  EXPECT_TRUE(empty.empty());
+  EXPECT_FALSE(empty.contains(0));
+  std::vector<std::pair<int, int>> twice = {{1, 1}, {2, 2}, {1, 3}};
+  EXPECT_THROW((s21::perfect_hash_map<int, int>(twice.begin(), twice.end())),
+               std::invalid_argument);
+}
+
+TEST(PerfectHashMapTest, RejectsFileOfOlderFormat) {
+  //  Files from before the default hasher became s21::hash carry this magic
+  const std::uint64_t old_magic = 0x687068706D6D3231ull;
+  auto items = Items(1000);
+  std::string path = testing::TempDir() + "s21_phm_old_" +
+                     std::to_string(::getpid());
+  Map(items.begin(), items.end()).save(path);
+  int fd = ::open(path.c_str(), O_WRONLY);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(::pwrite(fd, &old_magic, sizeof(old_magic), 0),
+            ssize_t(sizeof(old_magic)));
+  ::close(fd);
+  EXPECT_THROW(Map::load(path), std::runtime_error);
+  ::unlink(path.c_str());
+}
+
+TEST(PerfectHashMapTest, RejectsCorruptLevelsAndRanks) {
+  auto items = Items(5000);
+  std::string path = testing::TempDir() + "s21_phm_bad_" +
+                     std::to_string(::getpid());
+  Map(items.begin(), items.end()).save(path);
+  int fd = ::open(path.c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  std::uint64_t levels = 0;
+  ASSERT_EQ(::pread(fd, &levels, 8, 32), 8);
+  ASSERT_GE(levels, 2u);
+  //  Level starts follow the 64-byte header, the bits follow them
+  const off_t starts = 64;
+  const off_t words = off_t((64 + (levels + 1) * 8 + 63) & ~63ull);
+  auto rejected_with = [&](off_t offset, std::uint64_t value) {
+    std::uint64_t saved = 0;
+    EXPECT_EQ(::pread(fd, &saved, 8, offset), 8);
+    EXPECT_EQ(::pwrite(fd, &value, 8, offset), 8);
+    bool threw = false;
+    try {
+      Map::load(path);
+    } catch (const std::runtime_error &) {
+      threw = true;
+    }
+    EXPECT_EQ(::pwrite(fd, &saved, 8, offset), 8);
+    return threw;
+  };
+  EXPECT_TRUE(rejected_with(starts, 1));
+  EXPECT_TRUE(rejected_with(starts + 8, 0));
+  EXPECT_TRUE(rejected_with(words, 0));
+  EXPECT_TRUE(rejected_with(words, ~std::uint64_t{}));
+  EXPECT_EQ(Map::load(path).size(), items.size());
+  ::close(fd);
+  ::unlink(path.c_str());
+}
+
+TEST(PerfectHashMapTest, RejectsSizesThatWrapTheLayout) {
+  auto items = Items(5000);
+  std::string path = testing::TempDir() + "s21_phm_wrap_" +
+                     std::to_string(::getpid());
+  Map(items.begin(), items.end()).save(path);
+  int fd = ::open(path.c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  std::uint64_t header[8] = {};
+  ASSERT_EQ(::pread(fd, header, sizeof(header), 0), ssize_t(sizeof(header)));
+  const std::uint64_t count = header[3], levels = header[4], words = header[5];
+  auto size_words = [](std::uint64_t w) { return w + w / 8 + 1; };
+  //  A word count whose section size wraps to the real one, with the last
+  //  level stretched to match it, would walk the rank check off the file
+  std::uint64_t huge = words + ~std::uint64_t{} / 9 - 16;
+  while ((size_words(huge) - size_words(words)) % (std::uint64_t(1) << 61)) {
+    ++huge;
+  }
+  const off_t last_start = off_t(64 + levels * 8);
+  ASSERT_EQ(::pwrite(fd, &huge, 8, 40), 8);
+  ASSERT_EQ(::pwrite(fd, &huge, 8, last_start), 8);
+  EXPECT_THROW(Map::load(path), std::runtime_error);
+  ASSERT_EQ(::pwrite(fd, &words, 8, 40), 8);
+  ASSERT_EQ(::pwrite(fd, &words, 8, last_start), 8);
+  //  Same for an entry count whose byte size wraps
+  const std::uint64_t wrapped = count + (std::uint64_t(1) << 60);
+  ASSERT_EQ(::pwrite(fd, &wrapped, 8, 24), 8);
+  EXPECT_THROW(Map::load(path), std::runtime_error);
+  ASSERT_EQ(::pwrite(fd, &count, 8, 24), 8);
+  EXPECT_EQ(Map::load(path).size(), items.size());
+  ::close(fd);
+  ::unlink(path.c_str());
+}
@@ -0,0 +1,117 @@
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_persistent_map.h"
+#include "gtest/gtest.h"
+
+template <typename Map, typename Std>
+bool compare_persistent(const Map &map, const Std &std_map) {
+  if (map.size() != std_map.size()) return false;
+  auto i2 = map.begin();
+  for (auto i1 = std_map.begin(); i1 != std_map.end(); ++i1, ++i2) {
+    if (i1->first != i2->first || i1->second != i2->second) return false;
+  }
+  return i2 == map.end();
+}
+
+TEST(PersistentMapTest, DefaultConstructor) {
+  s21::persistent_map<int, int> a;
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.size(), 0);
+  EXPECT_TRUE(a.begin() == a.end());
+}
+
+TEST(PersistentMapTest, InsertFindErase) {
+  s21::persistent_map<int, std::string> a = {{2, "b"}, {1, "a"}, {3, "c"}};
+  EXPECT_FALSE(a.insert(2, "x"));
+  EXPECT_EQ(a.at(2), "b");
+  EXPECT_FALSE(a.insert_or_assign(2, "x"));
+  EXPECT_EQ(a.at(2), "x");
+  EXPECT_TRUE(a.insert_or_assign(4, "d"));
+  EXPECT_EQ(a.find(4)->second, "d");
+  EXPECT_TRUE(a.find(5) == a.end());
+  EXPECT_THROW(a.at(5), std::out_of_range);
+  EXPECT_TRUE(a.erase(1));
+  EXPECT_FALSE(a.erase(1));
+  EXPECT_FALSE(a.contains(1));
+  std::map<int, std::string> b = {{2, "x"}, {3, "c"}, {4, "d"}};
+  EXPECT_TRUE(compare_persistent(a, b));
+}
+
+TEST(PersistentMapTest, SnapshotsAreImmutable) {
+  s21::persistent_map<int, int> a;
+  std::map<int, int> b;
+  std::vector<s21::persistent_map<int, int>> versions;
+  std::vector<std::map<int, int>> expected;
+  unsigned seed = 3;
+  auto next = [&seed] { return (seed = seed * 1103515245 + 12345) >> 16; };
+  for (int i = 0; i < 3000; ++i) {
+    int key = next() % 500;
+    if (next() % 4 == 0) {
+      EXPECT_EQ(a.erase(key), b.erase(key) == 1);
+    } else {
+      int value = next();
+      a.insert_or_assign(key, value);
+      b[key] = value;
+    }
+    if (i % 100 == 0) {
+      versions.push_back(a.snapshot());
+      expected.push_back(b);
+      EXPECT_TRUE(versions.back().same_version(a));
+    }
+  }
+  EXPECT_TRUE(compare_persistent(a, b));
+  for (size_t i = 0; i < versions.size(); ++i) {
+    EXPECT_TRUE(compare_persistent(versions[i], expected[i]));
+  }
+  a.clear();
+  EXPECT_TRUE(compare_persistent(versions.back(), expected.back()));
+}
+
+TEST(PersistentMapTest, ReadersKeepTheirSnapshot) {
+  s21::persistent_map<int, int> a;
+  for (int i = 0; i < 1000; ++i) a.insert(i, i);
+  s21::persistent_map<int, int> snapshot = a;
+  std::thread reader([snapshot] {
+    for (int round = 0; round < 20; ++round) {
+      int expect = 0;
+      for (const auto &item : snapshot) {
+        EXPECT_EQ(item.first, expect);
+        EXPECT_EQ(item.second, expect);
+        ++expect;
+      }
+      EXPECT_EQ(expect, 1000);
+    }
+  });
+  for (int i = 0; i < 1000; ++i) {
+    a.insert_or_assign(i, -i);
+    if (i % 2) a.erase(i);
+  }
+  reader.join();
+  EXPECT_EQ(a.size(), 500);
+  EXPECT_EQ(snapshot.at(7), 7);
+}
+
+TEST(PersistentMapTest, SortedInsertsStayShallow) {
+  s21::persistent_map<int, int> a;
+  for (int i = 0; i < 100000; ++i) a.insert(i, i);
+  int expect = 0;
+  for (const auto &item : a) EXPECT_EQ(item.first, expect++);
+  EXPECT_EQ(expect, 100000);
+}
+
+TEST(MapTest, CopyKeepsShape) {
+  s21::map<int, int> a;
+  for (int i = 0; i < 100000; ++i) a.insert(a.end(), {i, i});
+  s21::map<int, int> b(a);
+  EXPECT_EQ(b.size(), a.size());
+  EXPECT_EQ(b.height(), a.height());
+  EXPECT_EQ(b.front().first, 0);
+  EXPECT_EQ(b.back().first, 99999);
+  b.insert(-1, 0);
+  EXPECT_EQ(b.begin()->first, -1);
+  EXPECT_EQ(a.begin()->first, 0);
+}
@@ -0,0 +1,73 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../s21_rcu_map.h"
+#include "gtest/gtest.h"
+
+TEST(RcuMapTest, Basics) {
+  s21::rcu_map<int, int> a = {{1, 10}, {2, 20}};
+  EXPECT_EQ(a.size(), 2);
+  EXPECT_TRUE(a.insert(3, 30));
+  EXPECT_FALSE(a.insert(3, 31));
+  EXPECT_FALSE(a.insert_or_assign(3, 32));
+  int value = 0;
+  EXPECT_TRUE(a.find(3, value));
+  EXPECT_EQ(value, 32);
+  EXPECT_TRUE(a.erase(1));
+  EXPECT_FALSE(a.contains(1));
+  EXPECT_FALSE(a.find(1, value));
+  EXPECT_EQ(a.size(), 2);
+}
+
+TEST(RcuMapTest, UpdatePublishesAtOnce) {
+  s21::rcu_map<int, int> a;
+  auto before = a.snapshot();
+  a.update([](auto &map) {
+    for (int i = 0; i < 100; ++i) map.insert(i, i);
+  });
+  EXPECT_TRUE(before.empty());
+  EXPECT_EQ(a.size(), 100);
+  int sum = a.read([](const auto &map) {
+    int total = 0;
+    for (const auto &item : map) total += item.second;
+    return total;
+  });
+  EXPECT_EQ(sum, 4950);
+}
+
+TEST(RcuMapTest, ReadersSeeWholeVersions) {
+  s21::rcu_map<int, int> a;
+  a.update([](auto &map) {
+    for (int i = 0; i < 64; ++i) map.insert(i, 0);
+  });
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        //  Every version holds one generation number in all values
+        bool same = a.read([](const auto &map) {
+          int first = map.begin()->second;
+          for (const auto &item : map) {
+            if (item.second != first) return false;
+          }
+          return map.size() == 64;
+        });
+        if (!same) ++torn;
+      }
+    });
+  }
+  for (int generation = 1; generation <= 300; ++generation) {
+    a.update([generation](auto &map) {
+      for (int i = 0; i < 64; ++i) map.insert_or_assign(i, generation);
+    });
+  }
+  done = true;
+  for (auto &reader : readers) reader.join();
+  EXPECT_EQ(torn.load(), 0);
+  int value = 0;
+  EXPECT_TRUE(a.find(5, value));
+  EXPECT_EQ(value, 300);
+}
@@ -1,5 +1,12 @@
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <iterator>
 #include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "../s21_binary_tree.h"
 #include "../s21_set.h"
@@ -119,6 +126,7 @@ TEST(SetTest, Find) {
   auto it = a.find("aaa");
   ASSERT_EQ("aaa", *it);
   auto it2 = a.find("b");
+  ASSERT_TRUE(it2 == a.end());
 }
 
 TEST(SetTest, CopyConstructor) {
@@ -172,6 +180,9 @@ TEST(SetTest, IteratorInsert) {
   auto pair2 = a.insert("ccc");
   auto pair3 = a.insert("eee");
   ASSERT_EQ("aaa", *pair.first);
+  ASSERT_EQ("bbb", *pair1.first);
+  ASSERT_EQ("ccc", *pair2.first);
+  ASSERT_EQ("eee", *pair3.first);
   ASSERT_EQ(false, a.contains("hhh"));
   ASSERT_EQ(true, a.contains("bbb"));
   ASSERT_EQ(true, a.contains("eee"));
@@ -566,3 +577,327 @@ TEST(SetTest, MaxSize) {
 
   EXPECT_TRUE(a1.max_size() > b1.max_size());
 }
+
+TEST(SetTest, Split) {
+  s21::set<int> a = {9, 10, 123, -4, 45, 1, 76, 34};
+  s21::set<int> b;
+  a.split(34, b);
+  EXPECT_TRUE(compare_set(a, std::set<int>{-4, 1, 9, 10}));
+  EXPECT_TRUE(compare_set(b, std::set<int>{34, 45, 76, 123}));
+  EXPECT_EQ(a.size(), 4);
+  EXPECT_EQ(b.size(), 4);
+}
+
+TEST(SetTest, Join) {
+  s21::set<int> a = {3, 1, 2};
+  s21::set<int> b = {7, 5, 6};
+  a.join(b);
+  EXPECT_TRUE(compare_set(a, std::set<int>{1, 2, 3, 5, 6, 7}));
+  EXPECT_EQ(a.size(), 6);
+  EXPECT_TRUE(b.empty());
+}
+
+TEST(SetTest, SetAlgebra) {
+  s21::set<int> a = {1, 3, 5, 7, 9};
+  s21::set<int> b = {3, 4, 5, 6};
+  s21::set<int> c(a), d(b), e(a), f(b);
+  a.set_union(b);
+  c.set_intersection(d);
+  e.set_difference(f);
+  EXPECT_TRUE(compare_set(a, std::set<int>{1, 3, 4, 5, 6, 7, 9}));
+  EXPECT_TRUE(compare_set(c, std::set<int>{3, 5}));
+  EXPECT_TRUE(compare_set(e, std::set<int>{1, 7, 9}));
+  EXPECT_EQ(a.size(), 7);
+  EXPECT_EQ(c.size(), 2);
+  EXPECT_EQ(e.size(), 3);
+  EXPECT_TRUE(b.empty());
+}
+
+TEST(SetTest, ParallelSetAlgebra) {
+  std::vector<int> x, y;
+  unsigned seed = 7;
+  for (int i = 0; i < 100000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    x.push_back(seed % 200000);
+    seed = seed * 1103515245 + 12345;
+    y.push_back(seed % 200000);
+  }
+  std::set<int> sx(x.begin(), x.end()), sy(y.begin(), y.end());
+  std::vector<int> expect;
+  auto same = [&expect](s21::set<int> &tree) {
+    return tree.size() == expect.size() &&
+           std::equal(expect.begin(), expect.end(), tree.begin());
+  };
+  s21::set<int> a, b;
+  a.bulk_insert(x.begin(), x.end());
+  b.bulk_insert(y.begin(), y.end());
+  expect.assign(sx.begin(), sx.end());
+  EXPECT_TRUE(same(a));
+  a.set_intersection(b);
+  expect.clear();
+  std::set_intersection(sx.begin(), sx.end(), sy.begin(), sy.end(),
+                        std::back_inserter(expect));
+  EXPECT_TRUE(same(a));
+
+  a.bulk_insert(x.begin(), x.end());
+  b.bulk_insert(y.begin(), y.end());
+  a.set_difference(b);
+  expect.clear();
+  std::set_difference(sx.begin(), sx.end(), sy.begin(), sy.end(),
+                      std::back_inserter(expect));
+  EXPECT_TRUE(same(a));
+
+  a.bulk_insert(x.begin(), x.end());
+  b.bulk_insert(y.begin(), y.end());
+  a.set_union(b);
+  expect.clear();
+  std::set_union(sx.begin(), sx.end(), sy.begin(), sy.end(),
+                 std::back_inserter(expect));
+  EXPECT_TRUE(same(a));
+}
+
+TEST(SetTest, SetAlgebraOnSortedInserts) {
+  //  Appending through the end() hint must not leave a chain behind
+  constexpr int kKeys = 1 << 20;
+  auto chain = [](int first, int step) {
+    s21::set<int> tree;
+    for (int i = 0; i < kKeys; ++i) tree.insert(tree.end(), first + i * step);
+    return tree;
+  };
+  s21::set<int> a = chain(0, 2), b = chain(kKeys, 1);
+  EXPECT_LE(a.height(), 64u);
+  a.set_union(b);
+  EXPECT_EQ(a.size(), kKeys + kKeys / 2);
+  EXPECT_LE(a.height(), 64u);
+
+  s21::set<int> c = chain(0, 1), d = chain(0, 3);
+  c.set_intersection(d);
+  EXPECT_EQ(c.size(), kKeys / 3 + 1);
+  s21::set<int> e = chain(0, 1), f = chain(0, 2);
+  e.set_difference(f);
+  EXPECT_EQ(e.size(), kKeys / 2);
+  EXPECT_EQ(e.front(), 1);
+
+  s21::set<int> g = chain(0, 1), h;
+  g.split(kKeys - 10, h);
+  EXPECT_EQ(g.size(), kKeys - 10);
+  EXPECT_EQ(h.size(), 10u);
+  EXPECT_EQ(h.front(), kKeys - 10);
+  g.split(5, h);
+  EXPECT_EQ(g.size(), 5u);
+  EXPECT_EQ(h.size(), kKeys - 15);
+  EXPECT_EQ(g.back(), 4);
+}
+
+TEST(SetTest, MergeDegenerateTree) {
+  constexpr int kKeys = 1 << 20;
+  s21::set<int> a = {-1, 5, kKeys + 1};
+  s21::set<int> b;
+  for (int i = 0; i < kKeys; ++i) b.insert(b.end(), i);
+  a.merge(b);
+  EXPECT_EQ(a.size(), kKeys + 2);
+  EXPECT_TRUE(b.empty());
+  int expected = -1;
+  for (int key : a) {
+    ASSERT_EQ(key, expected);
+    expected = expected == kKeys - 1 ? kKeys + 1 : expected + 1;
+  }
+
+  std::set<int> sx, sy;
+  s21::set<int> x, y;
+  unsigned seed = 3;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = seed % 4000;
+    (i % 2 ? sx : sy).insert(key);
+    (i % 2 ? x : y).insert(key);
+  }
+  sx.insert(sy.begin(), sy.end());
+  x.merge(y);
+  EXPECT_TRUE(compare_set(x, sx));
+}
+
+TEST(SetTest, InsertMovesKeys) {
+  s21::set<std::string> a;
+  std::string key(64, 'x');
+  EXPECT_TRUE(a.insert(std::move(key)).second);
+  EXPECT_TRUE(key.empty());
+  auto results = a.insert_many(std::string(64, 'y'), std::string(64, 'x'));
+  EXPECT_EQ(results.size(), 2);
+  EXPECT_TRUE(results[0].second);
+  EXPECT_FALSE(results[1].second);
+  EXPECT_EQ(a.size(), 2);
+}
+
+TEST(SetTest, MergeRelinksNodes) {
+  s21::set<std::string> a = {"a", "c"};
+  s21::set<std::string> b = {"b", "c", "d"};
+  const std::string *b_key = &*b.find("b");
+  a.merge(b);
+  EXPECT_EQ(&*a.find("b"), b_key);
+  EXPECT_EQ(a.size(), 4);
+  EXPECT_TRUE(b.empty());
+}
+
+TEST(SetTest, CachedEnds) {
+  s21::set<int> a = {5, 3, 8, 1, 4, 9};
+  EXPECT_EQ(*a.begin(), 1);
+  EXPECT_EQ(a.front(), 1);
+  EXPECT_EQ(a.back(), 9);
+  a.erase(a.begin());
+  EXPECT_EQ(*a.begin(), 3);
+  a.pop_min();
+  a.pop_max();
+  EXPECT_EQ(a.front(), 4);
+  EXPECT_EQ(a.back(), 8);
+  a.insert(0);
+  a.insert(10);
+  EXPECT_EQ(a.front(), 0);
+  EXPECT_EQ(a.back(), 10);
+  std::vector<int> keys(a.begin(), a.end());
+  EXPECT_EQ(keys, std::vector<int>({0, 4, 5, 8, 10}));
+  while (!a.empty()) a.pop_min();
+  EXPECT_EQ(a.begin(), a.end());
+  EXPECT_EQ(a.size(), 0);
+}
+
+TEST(SetTest, Bounds) {
+  s21::set<int> a = {10, 20, 30};
+  EXPECT_EQ(*a.lower_bound(20), 20);
+  EXPECT_EQ(*a.upper_bound(20), 30);
+  EXPECT_EQ(*a.lower_bound(15), 20);
+  EXPECT_EQ(a.upper_bound(30), a.end());
+  EXPECT_EQ(*a.find(30), 30);
+  EXPECT_EQ(a.find(25), a.end());
+}
+
+TEST(SetTest, SplitJoinKeepEnds) {
+  s21::set<int> a = {1, 2, 3, 4, 5, 6};
+  s21::set<int> b;
+  a.split(4, b);
+  EXPECT_EQ(a.back(), 3);
+  EXPECT_EQ(b.front(), 4);
+  b.pop_min();
+  a.join(b);
+  EXPECT_EQ(a.back(), 6);
+  std::vector<int> keys(a.begin(), a.end());
+  EXPECT_EQ(keys, std::vector<int>({1, 2, 3, 5, 6}));
+}
+
+TEST(SetTest, HintedInsert) {
+  s21::set<int> a;
+  for (int i = 0; i < 100; i += 2) {
+    EXPECT_EQ(*a.insert(a.end(), i), i);
+  }
+  EXPECT_EQ(*a.insert(a.find(10), 9), 9);
+  //  A wrong hint still lands the key in order
+  EXPECT_EQ(*a.insert(a.begin(), 51), 51);
+  EXPECT_EQ(*a.emplace_hint(a.end(), 99), 99);
+  EXPECT_EQ(*a.insert(a.end(), 4), 4);
+  EXPECT_EQ(a.size(), 53);
+  std::set<int> b(a.begin(), a.end());
+  EXPECT_TRUE(std::equal(a.begin(), a.end(), b.begin()));
+  EXPECT_EQ(a.front(), 0);
+  EXPECT_EQ(a.back(), 99);
+}
+
+TEST(SetTest, ShapeStats) {
+  s21::set<int> a;
+  EXPECT_EQ(a.height(), 0);
+  EXPECT_EQ(a.average_path_length(), 0.0);
+  a = {4};
+  EXPECT_EQ(a.height(), 1);
+  EXPECT_EQ(a.average_path_length(), 1.0);
+  a = {4, 2, 6, 1, 3, 5, 7};
+  for (int i = 8; i < 100; ++i) a.insert(a.end(), i);
+  auto levels = a.depth_histogram();
+  ASSERT_EQ(levels.size(), a.height());
+  EXPECT_EQ(levels[0], 1);
+  size_t total = 0, path = 0;
+  for (size_t depth = 0; depth < levels.size(); ++depth) {
+    EXPECT_GT(levels[depth], 0) << depth;
+    EXPECT_LE(levels[depth], size_t{1} << depth) << depth;
+    total += levels[depth];
+    path += levels[depth] * (depth + 1);
+  }
+  EXPECT_EQ(total, 99);
+  EXPECT_DOUBLE_EQ(a.average_path_length(), double(path) / 99);
+  EXPECT_LE(a.height(), 40);
+  std::ostringstream out;
+  a.dump_stats(out);
+  std::string prefix =
+      "{\"size\":99,\"height\":" + std::to_string(a.height()) + ",";
+  EXPECT_EQ(out.str().rfind(prefix, 0), 0);
+}
+
+namespace {
+//  Its comparison throws once the shared fuse runs out
+struct FusedKey {
+  static std::atomic<long> fuse;
+  int value;
+  FusedKey(int v = 0) : value(v) {}
+  bool operator<(const FusedKey &other) const {
+    if (fuse.fetch_sub(1) == 0) throw std::runtime_error("comparison");
+    return value < other.value;
+  }
+};
+std::atomic<long> FusedKey::fuse{-1};
+
+std::vector<int> Keys(const s21::set<FusedKey> &tree) {
+  std::vector<int> keys;
+  for (const FusedKey &key : tree) keys.push_back(key.value);
+  return keys;
+}
+}  // namespace
+
+TEST(SetTest, SetAlgebraSurvivesThrowingComparator) {
+  //  Large enough to fork, so the throw can land in either branch
+  constexpr int kKeys = 1 << 16;
+  for (int op = 0; op < 3; ++op) {
+    for (long fuse : {0L, 17L, 5000L, 60000L, 200000L}) {
+      FusedKey::fuse = -1;
+      s21::set<FusedKey> a, b;
+      for (int i = 0; i < kKeys; ++i) a.insert(a.end(), FusedKey(2 * i));
+      for (int i = 0; i < kKeys; ++i) b.insert(b.end(), FusedKey(3 * i));
+      std::set<int> all;
+      for (int i = 0; i < kKeys; ++i) all.insert({2 * i, 3 * i});
+      FusedKey::fuse = fuse;
+      try {
+        if (op == 0) a.set_union(b);
+        if (op == 1) a.set_intersection(b);
+        if (op == 2) a.set_difference(b);
+      } catch (const std::runtime_error &) {
+      }
+      FusedKey::fuse = -1;
+      //  Both trees are whole: sorted, sized right and disjoint from freed
+      //  nodes, which ASan would otherwise report
+      std::vector<int> x = Keys(a), y = Keys(b);
+      EXPECT_EQ(x.size(), a.size());
+      EXPECT_EQ(y.size(), b.size());
+      EXPECT_TRUE(std::is_sorted(x.begin(), x.end()));
+      EXPECT_TRUE(std::is_sorted(y.begin(), y.end()));
+      for (int key : x) EXPECT_EQ(all.count(key), 1) << key;
+      for (int key : y) EXPECT_EQ(all.count(key), 1) << key;
+      EXPECT_LE(a.height(), 64u);
+      EXPECT_LE(b.height(), 64u);
+      if (op == 0) {
+        //  A union frees only duplicates, so retrying finishes the job
+        a.set_union(b);
+        EXPECT_EQ(Keys(a), std::vector<int>(all.begin(), all.end()));
+      }
+    }
+  }
+}
+
+#ifdef S21_TREE_STATS
+TEST(SetTest, Counters) {
+  s21::reset_tree_counters();
+  {
+    s21::set<int> a = {2, 1, 3};
+    EXPECT_TRUE(a.contains(3));
+  }
+  EXPECT_EQ(s21::tree_counters().node_allocations, 3);
+  EXPECT_EQ(s21::tree_counters().node_deallocations, 3);
+  EXPECT_GT(s21::tree_counters().comparisons, 0);
+}
+#endif
@@ -0,0 +1,85 @@
+#include <map>
+#include <random>
+#include <string>
+
+#include "../s21_slab_map.h"
+#include "gtest/gtest.h"
+
+TEST(SlabMapTest, MatchesStdMap) {
+  s21::slab_map<int, std::string> map;
+  std::map<int, std::string> expected;
+  std::mt19937 rng(11);
+  for (int i = 0; i < 5000; ++i) {
+    int key = rng() % 700;
+    std::string value(rng() % 40, char('a' + i % 26));
+    switch (rng() % 4) {
+      case 0:
+        EXPECT_EQ(map.erase(key), expected.erase(key));
+        break;
+      case 1:
+        map.insert_or_assign(key, value);
+        expected[key] = value;
+        break;
+      case 2:
+        map[key] += value;
+        expected[key] += value;
+        break;
+      default:
+        EXPECT_EQ(map.insert(key, value).second,
+                  expected.emplace(key, value).second);
+    }
+  }
+  ASSERT_EQ(map.size(), expected.size());
+  auto want = expected.begin();
+  for (auto it = map.begin(); it != map.end(); ++it, ++want) {
+    ASSERT_EQ(it->first, want->first);
+    ASSERT_EQ(it->second, want->second);
+  }
+  std::size_t bytes = 0, expected_bytes = 0;
+  for (const std::string *value = map.values_begin();
+       value != map.values_end(); ++value) {
+    bytes += value->size();
+  }
+  for (const auto &item : expected) expected_bytes += item.second.size();
+  EXPECT_EQ(bytes, expected_bytes);
+  EXPECT_THROW(map.at(-1), std::out_of_range);
+}
+
+TEST(SlabMapTest, CopyMoveAndConstAccess) {
+  s21::slab_map<std::string, std::string> a = {
+      {"b", "2"}, {"a", "1"}, {"c", "3"}};
+  a.erase("b");
+  s21::slab_map<std::string, std::string> b(a);
+  a["a"] = "changed";
+  EXPECT_EQ(b.at("a"), "1");
+  EXPECT_EQ(b.at("c"), "3");
+  b.erase("a");
+  EXPECT_EQ(*b.values_begin(), "3");
+  b.erase(b.end());
+  b.erase(b.find("a"));
+  EXPECT_EQ(b.size(), 1u);
+  s21::slab_map<std::string, std::string> c(std::move(a));
+  EXPECT_TRUE(a.empty());
+  const auto &view = c;
+  auto it = view.find("a");
+  ASSERT_NE(it, view.end());
+  EXPECT_EQ((*it).second, "changed");
+  EXPECT_FALSE(view.contains("b"));
+  c = b;
+  EXPECT_EQ(c.size(), 1u);
+  EXPECT_EQ(c.begin()->first, "c");
+  auto placed = c.try_emplace("d", 3, 'x');
+  EXPECT_TRUE(placed.second);
+  EXPECT_EQ(placed.first->second, "xxx");
+}
+
+TEST(SlabMapTest, InsertFromOwnValueWhileGrowing) {
+  s21::slab_map<int, std::string> a;
+  for (int i = 0; i < 8; ++i) a.insert(i, std::string(40, char('a' + i)));
+  //  The slab is full, the argument lives in the slab being replaced
+  a.insert(8, a.at(3));
+  a.try_emplace(9, a.at(8));
+  EXPECT_EQ(a.at(8), std::string(40, 'd'));
+  EXPECT_EQ(a.at(9), std::string(40, 'd'));
+  EXPECT_EQ(a.at(3), std::string(40, 'd'));
+}
@@ -0,0 +1,45 @@
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include "../s21_static_map.h"
+#include "gtest/gtest.h"
+
+namespace {
+constexpr s21::static_map<int, std::string_view, 4> kNames{
+    {{30, "c"}, {10, "a"}, {40, "d"}, {20, "b"}}};
+constexpr auto kCodes = s21::make_static_map<std::string_view, int>(
+    {{"get", 1}, {"put", 2}, {"delete", 3}});
+constexpr auto kPrimes = s21::make_static_set<int>({7, 2, 5, 3, 11});
+
+//  Everything below is settled by the compiler
+static_assert(kNames.size() == 4);
+static_assert(kNames.begin()->first == 10);
+static_assert(kNames.at(20) == "b");
+static_assert(kNames.find(25) == kNames.end());
+static_assert(kCodes.at("delete") == 3);
+static_assert(!kCodes.contains("post"));
+static_assert(kPrimes.contains(7) && !kPrimes.contains(4));
+static_assert(*kPrimes.lower_bound(6) == 7);
+}  // namespace
+
+TEST(StaticMapTest, LookupsAtRunTime) {
+  int key = 30;
+  EXPECT_EQ(kNames.at(key), "c");
+  EXPECT_THROW(kNames.at(key + 1), std::out_of_range);
+  EXPECT_EQ(kCodes.count(std::string_view("put")), 1u);
+  std::vector<int> primes(kPrimes.begin(), kPrimes.end());
+  EXPECT_EQ(primes, std::vector<int>({2, 3, 5, 7, 11}));
+  EXPECT_THROW((s21::make_static_set<int>({1, 2, 1})), std::invalid_argument);
+}
+
+TEST(StaticMapTest, LowerBoundMatchesStd) {
+  int items[33];
+  for (int i = 0; i < 33; ++i) items[i] = 2 * ((i * 7) % 33);
+  s21::static_set<int, 33> set(items);
+  std::sort(items, items + 33);
+  for (int key = -1; key <= 66; ++key) {
+    EXPECT_EQ(set.lower_bound(key) - set.begin(),
+              std::lower_bound(items, items + 33, key) - items);
+  }
+}
@@ -0,0 +1,233 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../s21_unordered_map.h"
+#include "gtest/gtest.h"
+
+namespace {
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view text) const {
+    return std::hash<std::string_view>()(text);
+  }
+};
+
+//  Every key lands in the same home group
+struct ConstantHash {
+  std::size_t operator()(int) const { return 42; }
+};
+
+//  Counts live copies and throws once copies_left runs out
+struct Bomb {
+  static inline int live = 0;
+  static inline int copies_left = -1;
+  Bomb() { ++live; }
+  Bomb(const Bomb &) {
+    if (copies_left == 0) throw std::runtime_error("Bomb");
+    if (copies_left > 0) --copies_left;
+    ++live;
+  }
+  ~Bomb() { --live; }
+};
+}  // namespace
+
+TEST(UnorderedMapTest, BasicOperations) {
+  s21::unordered_map<int, std::string> map = {{1, "a"}, {2, "b"}};
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map.at(1), "a");
+  EXPECT_THROW(map.at(3), std::out_of_range);
+  map[3] = "c";
+  EXPECT_EQ(map.insert(3, "x").second, false);
+  EXPECT_EQ(map.insert_or_assign(3, "d").second, false);
+  EXPECT_EQ(map[3], "d");
+  EXPECT_TRUE(map.emplace(4, "e").second);
+  EXPECT_TRUE(map.try_emplace(5, 3, 'f').second);
+  EXPECT_EQ(map.find(5)->second, "fff");
+  EXPECT_EQ(map.find(6), map.end());
+  EXPECT_EQ(map.erase(1), 1u);
+  EXPECT_EQ(map.erase(1), 0u);
+  map.erase(map.find(2));
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.size(), 3u);
+  s21::unordered_map<int, std::string> copy(map);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(copy.count(4), 1u);
+  map = std::move(copy);
+  EXPECT_EQ(map.size(), 3u);
+}
+
+TEST(UnorderedMapTest, MatchesStdUnorderedMap) {
+  s21::unordered_map<long, long> map;
+  std::unordered_map<long, long> expected;
+  std::mt19937 rng(7);
+  for (int i = 0; i < 200000; ++i) {
+    long key = rng() % 5000;
+    if (rng() % 3 == 0) {
+      ASSERT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      map[key] += i;
+      expected[key] += i;
+    }
+  }
+  ASSERT_EQ(map.size(), expected.size());
+  std::size_t seen = 0;
+  for (const auto &item : map) {
+    ASSERT_EQ(expected.at(item.first), item.second);
+    ++seen;
+  }
+  EXPECT_EQ(seen, expected.size());
+  EXPECT_LE(map.load_factor(), 0.875f);
+}
+
+TEST(UnorderedMapTest, TombstonesAreReclaimed) {
+  s21::unordered_map<int, int, ConstantHash> map;
+  for (int round = 0; round < 50; ++round) {
+    for (int i = 0; i < 40; ++i) map.insert(round * 100 + i, i);
+    for (int i = 0; i < 40; i += 2) map.erase(round * 100 + i);
+    for (int i = 1; i < 40; i += 2) EXPECT_EQ(map.at(round * 100 + i), i);
+    for (int i = 1; i < 40; i += 2) map.erase(round * 100 + i);
+  }
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.bucket_count(), 64u);
+}
+
+TEST(UnorderedMapTest, ReserveAndHeterogeneousLookup) {
+  s21::unordered_map<std::string, int, StringHash, std::equal_to<>> map;
+  map.reserve(1000);
+  std::size_t buckets = map.bucket_count();
+  for (int i = 0; i < 1000; ++i) map.insert(std::to_string(i), i);
+  EXPECT_EQ(map.bucket_count(), buckets);
+  EXPECT_EQ(map.find(std::string_view("999"))->second, 999);
+  EXPECT_TRUE(map.contains("17"));
+  EXPECT_EQ(map.erase(std::string_view("17")), 1u);
+  EXPECT_FALSE(map.contains(std::string_view("17")));
+  map.rehash(0);
+  EXPECT_LT(map.bucket_count(), buckets * 2);
+  EXPECT_EQ(map.at("500"), 500);
+}
+
+TEST(UnorderedMapTest, IncrementalResizeMatchesStd) {
+  s21::incremental_unordered_map<int, std::string> map;
+  std::unordered_map<int, std::string> expected;
+  std::mt19937 rng(11);
+  bool saw_migration = false;
+  for (int i = 0; i < 50000; ++i) {
+    int key = rng() % 20000;
+    if (rng() % 4 == 0) {
+      ASSERT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      map.insert_or_assign(key, std::to_string(i));
+      expected[key] = std::to_string(i);
+    }
+    if (map.migrating()) {
+      saw_migration = true;
+      ASSERT_EQ(map.contains(key), expected.count(key) == 1);
+      std::size_t seen = 0;
+      if (i % 97 == 0) {
+        for (const auto &item : map) {
+          ASSERT_EQ(expected.at(item.first), item.second);
+          ++seen;
+        }
+        ASSERT_EQ(seen, expected.size());
+      }
+    }
+  }
+  EXPECT_TRUE(saw_migration);
+  ASSERT_EQ(map.size(), expected.size());
+  s21::incremental_unordered_map<int, std::string> copy(map);
+  for (const auto &item : expected) {
+    ASSERT_EQ(copy.at(item.first), item.second);
+  }
+  for (auto it = map.begin(); it != map.end();) map.erase(it++);
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(UnorderedMapTest, ErasesFinishMigration) {
+  s21::incremental_unordered_map<int, int> map;
+  int n = 0;
+  while (!map.migrating()) map.try_emplace(n, n), ++n;
+  //  Erasing alone has to drain the old table, not keep both forever
+  int erased = 0;
+  while (map.migrating() && erased < n) map.erase(erased++);
+  EXPECT_FALSE(map.migrating());
+  EXPECT_LT(erased, n);
+  EXPECT_EQ(map.size(), size_t(n - erased));
+  for (int i = 0; i < n; ++i) ASSERT_EQ(map.contains(i), i >= erased) << i;
+}
+
+TEST(UnorderedMapTest, EmplaceFromOwnValueAcrossGrowth) {
+  //  Every growth and migration step moves the value being copied
+  s21::unordered_map<int, std::string> map;
+  s21::incremental_unordered_map<int, std::string> incremental;
+  map.try_emplace(0, 40, 'x');
+  incremental.try_emplace(0, 40, 'x');
+  for (int i = 1; i < 3000; ++i) {
+    map.try_emplace(i, map.at(i - 1));
+    incremental.try_emplace(i, incremental.at(i - 1));
+    ASSERT_EQ(map.at(i), std::string(40, 'x'));
+    ASSERT_EQ(incremental.at(i), std::string(40, 'x'));
+  }
+  EXPECT_EQ(map.size(), 3000u);
+  EXPECT_EQ(incremental.size(), 3000u);
+}
+
+//  Bomb has no move, so every resize copies. Inserts keep going until the
+//  one that resizes throws; the table must be left as it was.
+template <class BombMap>
+void InsertUntilResizeThrows(BombMap &map, int *next) {
+  int elsewhere = Bomb::live - int(map.size());
+  Bomb::copies_left = 0;
+  for (;; ++*next) {
+    size_t size = map.size();
+    try {
+      map[*next];
+    } catch (const std::runtime_error &) {
+      EXPECT_EQ(map.size(), size);
+      break;
+    }
+  }
+  Bomb::copies_left = -1;
+  EXPECT_FALSE(map.contains(*next));
+  EXPECT_EQ(Bomb::live - elsewhere, int(map.size()));
+  for (int i = 0; i < *next; ++i) ASSERT_TRUE(map.contains(i)) << i;
+}
+
+TEST(UnorderedMapTest, ThrowingCopyKeepsTable) {
+  Bomb::live = 0;
+  Bomb::copies_left = -1;
+  {
+    using BombMap = s21::unordered_map<int, Bomb>;
+    BombMap map;
+    int next = 0;
+    InsertUntilResizeThrows(map, &next);
+    //  A copy of the whole table fails half way
+    Bomb::copies_left = int(map.size()) / 2;
+    EXPECT_THROW(BombMap copy(map), std::runtime_error);
+    EXPECT_EQ(Bomb::live, int(map.size()));
+    Bomb::copies_left = -1;
+    using Entry = std::pair<const int, Bomb>;
+    std::initializer_list<Entry> items = {Entry(0, Bomb()), Entry(1, Bomb()),
+                                          Entry(2, Bomb()), Entry(3, Bomb())};
+    Bomb::copies_left = 2;
+    EXPECT_THROW(BombMap list(items), std::runtime_error);
+    EXPECT_EQ(Bomb::live, int(map.size()) + 4);
+    Bomb::copies_left = -1;
+    map[next];
+    EXPECT_EQ(map.size(), size_t(next) + 1);
+
+    //  Incremental: the throw comes from the migration step of an insert,
+    //  which takes the new value back out; later inserts finish the move
+    s21::incremental_unordered_map<int, Bomb> incremental;
+    next = 0;
+    InsertUntilResizeThrows(incremental, &next);
+    for (int i = next; i < 4 * next; ++i) incremental[i];
+    for (int i = 0; i < 4 * next; ++i) ASSERT_TRUE(incremental.contains(i));
+    EXPECT_EQ(Bomb::live,
+              int(items.size() + map.size() + incremental.size()));
+  }
+  EXPECT_EQ(Bomb::live, 0);
+}
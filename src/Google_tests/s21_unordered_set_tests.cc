@@ -0,0 +1,37 @@
+#include <set>
+#include <string>
+
+#include "../s21_unordered_set.h"
+#include "gtest/gtest.h"
+
+TEST(UnorderedSetTest, BasicOperations) {
+  s21::unordered_set<std::string> set = {"a", "b", "a"};
+  EXPECT_EQ(set.size(), 2u);
+  EXPECT_FALSE(set.insert("b").second);
+  EXPECT_TRUE(set.emplace(3, 'c').second);
+  EXPECT_EQ(*set.find("ccc"), "ccc");
+  EXPECT_EQ(set.erase("a"), 1u);
+  std::set<std::string> items(set.begin(), set.end());
+  EXPECT_EQ(items, std::set<std::string>({"b", "ccc"}));
+  s21::unordered_set<std::string> copy;
+  copy = set;
+  set.clear();
+  EXPECT_TRUE(copy.contains("b"));
+  EXPECT_FALSE(set.contains("b"));
+}
+
+TEST(UnorderedSetTest, IncrementalResize) {
+  s21::incremental_unordered_set<int> set;
+  for (int i = 0; i < 1000; ++i) {
+    set.insert(i);
+    if (set.migrating()) {
+      EXPECT_TRUE(set.contains(i / 2));
+      EXPECT_EQ(*set.find(i), i);
+    }
+  }
+  EXPECT_FALSE(set.migrating());
+  EXPECT_EQ(set.size(), 1000u);
+  set.rehash(0);
+  EXPECT_EQ(set.erase(500), 1u);
+  EXPECT_EQ(std::distance(set.begin(), set.end()), 999);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "../s21_containers.h"
@@ -417,3 +419,273 @@ TEST(vector, insert_many_back_function) {
     EXPECT_EQ(std_vector1[i], s21_vector1[i]);
   }
 }
+
+namespace {
+//  Counts how elements reach their slots during growth and shifting
+template <bool NoexceptMove>
+struct Tracked {
+  static inline int copies = 0;
+  static inline int moves = 0;
+  int value;
+  Tracked(int v = 0) : value(v) {}
+  Tracked(const Tracked &other) : value(other.value) { ++copies; }
+  Tracked(Tracked &&other) noexcept(NoexceptMove) : value(other.value) {
+    ++moves;
+  }
+  Tracked &operator=(const Tracked &) = default;
+  Tracked &operator=(Tracked &&other) noexcept(NoexceptMove) {
+    value = other.value;
+    ++moves;
+    return *this;
+  }
+  static void Reset() { copies = moves = 0; }
+};
+
+struct Handle {
+  std::unique_ptr<int> owned;
+  Handle(int v = 0) : owned(new int(v)) {}
+  Handle(const Handle &other) : owned(new int(*other.owned)) {}
+  Handle(Handle &&other) noexcept : owned(std::move(other.owned)) {
+    ++moves;
+  }
+  static inline int moves = 0;
+  static void Reset() { moves = 0; }
+};
+}  // namespace
+
+template <>
+struct s21::is_trivially_relocatable<Handle> : std::true_type {};
+
+TEST(vector, growth_moves_noexcept_elements) {
+  using Movable = Tracked<true>;
+  s21::vector<Movable> values = {1, 2, 3, 4, 5};
+  Movable::Reset();
+  values.reserve(100);
+  values.shrink_to_fit();
+  values.erase(values.begin());
+  EXPECT_EQ(Movable::copies, 0);
+  EXPECT_EQ(Movable::moves, 5 + 5 + 4);
+  EXPECT_EQ(values[0].value, 2);
+  EXPECT_EQ(values.size(), 4u);
+}
+
+TEST(vector, growth_copies_throwing_moves) {
+  using Copyable = Tracked<false>;
+  Copyable::Reset();
+  s21::vector<Copyable> values;
+  for (int i = 0; i < 16; ++i) {
+    Copyable item(i);
+    values.push_back(item);
+  }
+  EXPECT_EQ(Copyable::moves, 0);
+  for (int i = 0; i < 16; ++i) EXPECT_EQ(values[i].value, i);
+}
+
+TEST(vector, relocatable_elements_are_not_moved) {
+  Handle::Reset();
+  s21::vector<Handle> values;
+  for (int i = 0; i < 40; ++i) {
+    Handle item(i);
+    values.push_back(item);
+  }
+  Handle first(-1);
+  values.insert(values.begin(), first);
+  values.erase(values.begin() + 5);
+  EXPECT_EQ(Handle::moves, 0);
+  EXPECT_EQ(*values[0].owned, -1);
+  EXPECT_EQ(*values[5].owned, 5);
+  EXPECT_EQ(*values[39].owned, 39);
+}
+
+TEST(vector, growth_moves_nested_vectors) {
+  s21::vector<s21::vector<int>> values;
+  s21::vector<const int *> buffers;
+  for (int i = 0; i < 40; ++i) {
+    s21::vector<int> inner = {i, i + 1, i + 2};
+    values.push_back(inner);
+    buffers.push_back(values[i].data());
+  }
+  values.reserve(1000);
+  values.erase(values.begin());
+  for (int i = 0; i < 39; ++i) {
+    EXPECT_EQ(values[i].data(), buffers[i + 1]);
+    EXPECT_EQ(values[i][2], i + 3);
+  }
+}
+
+TEST(vector, strings_survive_growth_insert_and_erase) {
+  std::vector<std::string> expected;
+  s21::vector<std::string> values;
+  for (int i = 0; i < 50; ++i) {
+    std::string text(40, char('a' + i % 26));
+    expected.push_back(text);
+    values.push_back(text);
+  }
+  expected.insert(expected.begin() + 7, "inserted");
+  values.insert(values.begin() + 7, "inserted");
+  expected.erase(expected.begin() + 3);
+  values.erase(values.begin() + 3);
+  values.pop_back();
+  expected.pop_back();
+  ASSERT_EQ(values.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(values[i], expected[i]);
+  }
+}
+
+namespace {
+//  Counts every way an element can come into being
+struct Built {
+  static inline int constructed = 0;
+  static inline int copied = 0;
+  static inline int moved = 0;
+  int a, b;
+  Built(int x, int y) : a(x), b(y) { ++constructed; }
+  Built(const Built &other) : a(other.a), b(other.b) { ++copied; }
+  Built(Built &&other) noexcept : a(other.a), b(other.b) { ++moved; }
+  static void Reset() { constructed = copied = moved = 0; }
+};
+
+struct ThrowsOnThree {
+  int value;
+  ThrowsOnThree(int v) : value(v) {
+    if (v == 3) throw std::runtime_error("three");
+  }
+};
+
+//  Copies and moves, which may throw, fail once the budget runs out
+struct Fragile {
+  static inline int budget = -1;
+  std::unique_ptr<int> owned;
+  Fragile(int v) : owned(new int(v)) {}
+  Fragile(const Fragile &other) : owned(new int(Spend(*other.owned))) {}
+  Fragile(Fragile &&other) : Fragile(static_cast<const Fragile &>(other)) {}
+  Fragile &operator=(const Fragile &other) {
+    *owned = Spend(*other.owned);
+    return *this;
+  }
+  Fragile &operator=(Fragile &&other) {
+    return *this = static_cast<const Fragile &>(other);
+  }
+  static int Spend(int value) {
+    if (budget == 0) throw std::runtime_error("budget");
+    if (budget > 0) --budget;
+    return value;
+  }
+};
+}  // namespace
+
+TEST(vector, emplace_constructs_in_place) {
+  s21::vector<Built> values;
+  values.reserve(8);
+  Built::Reset();
+  Built &back = values.emplace_back(1, 2);
+  EXPECT_EQ(back.b, 2);
+  values.emplace(values.begin(), 3, 4);
+  values.emplace(values.begin() + 1, 5, 6);
+  EXPECT_EQ(Built::constructed, 3);
+  EXPECT_EQ(Built::copied, 0);
+  EXPECT_EQ(values[0].a, 3);
+  EXPECT_EQ(values[1].a, 5);
+  EXPECT_EQ(values[2].a, 1);
+}
+
+TEST(vector, push_back_rvalue_moves_once) {
+  s21::vector<Built> values;
+  values.reserve(4);
+  Built::Reset();
+  values.push_back(Built(1, 1));
+  Built item(2, 2);
+  values.push_back(item);
+  EXPECT_EQ(Built::moved, 1);
+  EXPECT_EQ(Built::copied, 1);
+
+  s21::vector<std::unique_ptr<int>> owners;
+  for (int i = 0; i < 10; ++i) owners.push_back(std::make_unique<int>(i));
+  owners.emplace(owners.begin(), new int(-1));
+  EXPECT_EQ(*owners[0], -1);
+  EXPECT_EQ(*owners[10], 9);
+}
+
+TEST(vector, insert_many_without_temporaries) {
+  s21::vector<Built> values;
+  values.reserve(8);
+  Built first(1, 1), second(2, 2);
+  values.push_back(first);
+  Built::Reset();
+  values.insert_many(values.begin(), first, Built(3, 3));
+  values.insert_many_back(second);
+  //  One move for the argument, one for shifting the old element and two
+  //  for carrying the elements built aside into the gap
+  EXPECT_EQ(Built::copied, 2);
+  EXPECT_EQ(Built::moved, 4);
+  EXPECT_EQ(values.size(), 4u);
+  EXPECT_EQ(values[1].a, 3);
+  EXPECT_EQ(values[3].a, 2);
+}
+
+TEST(vector, insert_of_own_element) {
+  s21::vector<std::string> values = {"a", "b", "c"};
+  values.push_back(values[0]);
+  values.reserve(10);
+  values.insert(values.begin(), values[2]);
+  values.emplace(values.begin() + 1, values.back());
+  std::vector<std::string> expected = {"c", "a", "a", "b", "c", "a"};
+  ASSERT_EQ(values.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(values[i], expected[i]);
+  }
+  //  Arguments that are members of, or point into, a shifted element
+  s21::vector<std::pair<int, std::string>> pairs;
+  pairs.reserve(4);
+  pairs.emplace_back(0, std::string(40, 'a'));
+  pairs.emplace_back(1, std::string(40, 'b'));
+  pairs.emplace(pairs.begin(), pairs[1].first, pairs[1].second);
+  EXPECT_EQ(pairs[0].first, 1);
+  EXPECT_EQ(pairs[0].second, std::string(40, 'b'));
+  EXPECT_EQ(pairs[2].second, std::string(40, 'b'));
+  s21::vector<std::string> texts = {"xy", "zw"};
+  texts.reserve(4);
+  texts.emplace(texts.begin(), texts[1].c_str());
+  texts.insert_many(texts.begin() + 1, texts[2].c_str(), texts[0]);
+  std::vector<std::string> want = {"zw", "zw", "zw", "xy", "zw"};
+  ASSERT_EQ(texts.size(), want.size());
+  for (std::size_t i = 0; i < want.size(); ++i) EXPECT_EQ(texts[i], want[i]);
+}
+
+TEST(vector, failed_insert_leaves_vector_unchanged) {
+  s21::vector<ThrowsOnThree> values;
+  values.emplace_back(1);
+  values.emplace_back(2);
+  EXPECT_THROW(values.insert_many(values.begin() + 1, 7, 3),
+               std::runtime_error);
+  values.reserve(10);
+  EXPECT_THROW(values.insert_many(values.begin(), 8, 3), std::runtime_error);
+  ASSERT_EQ(values.size(), 2u);
+  EXPECT_EQ(values[0].value, 1);
+  EXPECT_EQ(values[1].value, 2);
+}
+
+TEST(vector, throwing_copies_leave_no_holes) {
+  s21::vector<Fragile> values;
+  values.reserve(10);
+  for (int i = 0; i < 5; ++i) values.emplace_back(i);
+  //  Room to spare, but a throwing shift would strand a moved-from gap
+  Fragile::budget = 2;
+  EXPECT_THROW(values.insert(values.begin() + 1, values[4]),
+               std::runtime_error);
+  ASSERT_EQ(values.size(), 5u);
+  for (int i = 0; i < 5; ++i) EXPECT_EQ(*values[i].owned, i);
+
+  Fragile::budget = 1;
+  EXPECT_THROW(values.erase(values.begin()), std::runtime_error);
+  ASSERT_EQ(values.size(), 5u);
+  for (int i = 0; i < 5; ++i) ASSERT_NE(values[i].owned, nullptr);
+
+  Fragile::budget = -1;
+  values.insert(values.begin() + 1, values[4]);
+  values.erase(values.begin());
+  ASSERT_EQ(values.size(), 5u);
+  EXPECT_EQ(*values[0].owned, 4);
+  EXPECT_EQ(*values[4].owned, 4);
+}
@@ -1,15 +1,26 @@
 #ifndef CONTAINERS_SRC_S21_BINARY_TREE_H_
 #define CONTAINERS_SRC_S21_BINARY_TREE_H_
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <exception>
 #include <functional>
+#include <future>
+#include <ostream>
+#include <system_error>
+#include <thread>
 
 #include "s21_stack.h"
+#include "s21_tree_stats.h"
 #include "s21_vector.h"
 
 namespace s21 {
+//  Treap: keys are in search order and every node's random priority is at
+//  least its children's, so the expected depth is O(log n) whatever order
+//  keys arrive in. Multi lets equal keys coexist, in insertion order.
 template <class Key, class Compare = std::less<Key>,
-          class Allocator = std::allocator<Key>>
+          class Allocator = std::allocator<Key>, bool Multi = false>
 class BinaryTree {
  public:
   class Node;
@@ -24,9 +35,13 @@ class BinaryTree {
   class Node {
    public:
     Key key{};
+    //  Next to the key, so small keys leave room for it in the padding
+    std::uint32_t priority{};
     Node *left{};
     Node *right{};
-    Node(Key key) : key(key) {}
+    Node *parent{};
+    template <class... Args>
+    explicit Node(Args &&...args) : key(std::forward<Args>(args)...) {}
   };  //  Class Node
 
   class BTreeIterator {
@@ -38,17 +53,7 @@ class BinaryTree {
     using reference = value_type &;
     using difference_type = std::ptrdiff_t;
     using iterator_category = std::forward_iterator_tag;
-    BTreeIterator(Node *node) : current_node_(node) {
-      while (current_node_ != nullptr) {
-        nodeStack.push(current_node_);
-        current_node_ = current_node_->left;
-      }
-
-      if (!nodeStack.empty()) {
-        current_node_ = nodeStack.top();
-        nodeStack.pop();
-      }
-    }
+    BTreeIterator(Node *node) : current_node_(node) {}
     reference operator*() const { return current_node_->key; }
     pointer operator->() const { return &(current_node_->key); }
     bool operator==(const iterator &other) const {
@@ -58,20 +63,7 @@ class BinaryTree {
       return !(current_node_ == other.current_node_);
     }
     iterator &operator++() {
-      if (current_node_->right != nullptr) {
-        Node *temp = current_node_->right;
-        while (temp != nullptr) {
-          nodeStack.push(temp);
-          temp = temp->left;
-        }
-      }
-      if (!nodeStack.empty()) {
-        current_node_ = nodeStack.top();
-        nodeStack.pop();
-      } else {
-        current_node_ = nullptr;
-      }
-
+      current_node_ = Next(current_node_);
       return *this;
     }
     iterator operator++(int) {
@@ -82,7 +74,6 @@ class BinaryTree {
 
    private:
     Node *current_node_;
-    s21::stack<Node *> nodeStack;
 
   };  //  class BTreeIterator
   class ConstBTreeIterator {
@@ -95,16 +86,9 @@ class BinaryTree {
     using difference_type = std::ptrdiff_t;
     using iterator_category = std::forward_iterator_tag;
 
-    ConstBTreeIterator(Node *node) : current_node_(node) {
-      while (current_node_ != nullptr) {
-        nodeStack.push(current_node_);
-        current_node_ = current_node_->left;
-      }
-      if (!nodeStack.empty()) {
-        current_node_ = nodeStack.top();
-        nodeStack.pop();
-      }
-    }
+    ConstBTreeIterator(Node *node) : current_node_(node) {}
+    ConstBTreeIterator(const iterator &other)
+        : current_node_(other.current_node_) {}
 
     reference operator*() const { return current_node_->key; }
     pointer operator->() const { return &(current_node_->key); }
@@ -116,19 +100,7 @@ class BinaryTree {
     }
 
     const_iterator &operator++() {
-      if (current_node_->right != nullptr) {
-        Node *temp = current_node_->right;
-        while (temp != nullptr) {
-          nodeStack.push(temp);
-          temp = temp->left;
-        }
-      }
-      if (!nodeStack.empty()) {
-        current_node_ = nodeStack.top();
-        nodeStack.pop();
-      } else {
-        current_node_ = nullptr;
-      }
+      current_node_ = Next(current_node_);
       return *this;
     }
 
@@ -140,7 +112,6 @@ class BinaryTree {
 
    private:
     Node *current_node_;
-    s21::stack<Node *> nodeStack;
   };  // class const BTreeIterator
 
   BinaryTree() { root_ = nullptr; }
@@ -167,41 +138,109 @@ class BinaryTree {
     return *this;
   }
 
-  BinaryTree operator=(BinaryTree &&s) noexcept {
+  BinaryTree &operator=(BinaryTree &&s) noexcept {
     if (this != &s) {
       clear();
       root_ = s.root_;
-      s.root_ = nullptr;
+      leftmost_ = s.leftmost_;
+      rightmost_ = s.rightmost_;
+      s.root_ = s.leftmost_ = s.rightmost_ = nullptr;
       allocator_ = s.allocator_;
       size_ = s.size_;
+      s.size_ = 0;
     }
     return *this;
   };
 
   void clear() {
     DestroyTree(root_);
-    root_ = nullptr;
+    root_ = leftmost_ = rightmost_ = nullptr;
   }
 
-  iterator begin() { return iterator(root_); }
+  iterator begin() { return iterator(leftmost_); }
   iterator end() { return iterator(nullptr); }
-  const_iterator begin() const { return const_iterator(root_); }
+  const_iterator begin() const { return const_iterator(leftmost_); }
   const_iterator end() const { return const_iterator(nullptr); }
-  bool empty() { return (root_ == nullptr); }
-  size_type size() { return size_; }
+  bool empty() const { return (root_ == nullptr); }
+  size_type size() const { return size_; }
   size_type max_size() const {
     return std::allocator_traits<allocator_type>::max_size(allocator_);
   }
 
+  //  Smallest and largest keys, the tree must not be empty
+  Key &front() { return leftmost_->key; }
+  Key &back() { return rightmost_->key; }
+
+  //  Remove the smallest or largest key, O(1) apart from the deallocation
+  void pop_min() {
+    if (leftmost_ != nullptr) {
+      Node *node = leftmost_;
+      Unlink(node);
+      DealocNode(node);
+    }
+  }
+
+  void pop_max() {
+    if (rightmost_ != nullptr) {
+      Node *node = rightmost_;
+      Unlink(node);
+      DealocNode(node);
+    }
+  }
+
   bool contains(const Key &key) { return (Search(key) != nullptr); }
 
   std::pair<iterator, bool> insert(const Key &value) {
-    Node *ins{};
-    root_ = InsertIt(root_, value, &ins);
+    Node *ins = InsertIt(value);
+    return std::make_pair(iterator(ins), (ins != nullptr));
+  }
+
+  std::pair<iterator, bool> insert(Key &&value) {
+    Node *ins = InsertIt(std::move(value));
     return std::make_pair(iterator(ins), (ins != nullptr));
   }
 
-  void erase(iterator pos) { erase(pos.current_node_, root_); }
+  //  Builds the key in its node; the node is dropped if the key is present
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    Node *node = NewNode(std::forward<Args>(args)...);
+    if (!InsertNode(node)) {
+      DealocNode(node);
+      node = nullptr;
+    }
+    return std::make_pair(iterator(node), (node != nullptr));
+  }
+
+  //  Inserts as close as possible before `hint`. A correct hint, such as
+  //  end() for keys arriving in order, makes the insertion amortized O(1).
+  iterator insert(const_iterator hint, const Key &value) {
+    return iterator(InsertHint(hint.current_node_, value));
+  }
+
+  iterator insert(const_iterator hint, Key &&value) {
+    return iterator(InsertHint(hint.current_node_, std::move(value)));
+  }
+
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    Node *node = NewNode(std::forward<Args>(args)...);
+    Node *parent{};
+    Node **link{};
+    Node *found = FindHintLink(hint.current_node_, node->key, &parent, &link);
+    if (found != nullptr) {
+      DealocNode(node);
+      return iterator(found);
+    }
+    Attach(node, parent, link);
+    return iterator(node);
+  }
+
+  void erase(iterator pos) {
+    if (pos.current_node_ != nullptr) {
+      Unlink(pos.current_node_);
+      DealocNode(pos.current_node_);
+    }
+  }
 
   void merge(BinaryTree &other) noexcept {
     if (other.root_ == nullptr) {
@@ -210,182 +249,944 @@ class BinaryTree {
     if (root_ == nullptr) {
       this->swap(other);
     } else {
-      iterator it = other.begin();
-      iterator fin = other.end();
-      for (; it != fin; ++it) {
-        this->insert(*it);
-      }
-      other.clear();
+      MergeNodes(other.leftmost_);
+      other.root_ = other.leftmost_ = other.rightmost_ = nullptr;
+      other.size_ = 0;
     }
   }
 
   void swap(BinaryTree &other) noexcept {
     std::swap(root_, other.root_);
+    std::swap(leftmost_, other.leftmost_);
+    std::swap(rightmost_, other.rightmost_);
     std::swap(size_, other.size_);
     std::swap(allocator_, other.allocator_);
   }
 
+  //  For Multi the first of the equal keys is found
   iterator find(const Key &key) {
-    iterator it = this->begin();
-    iterator fin = this->end();
-    for (; it != fin; ++it) {
-      if (!Less(key, *it) && !Less(*it, key)) {
-        break;
+    if (Multi) {
+      iterator it = lower_bound(key);
+      return (it == end() || Less(key, *it)) ? end() : it;
+    }
+    return iterator(Search(key));
+  }
+
+  //  First key not less than `key`
+  iterator lower_bound(const Key &key) {
+    Node *node = root_;
+    Node *bound = nullptr;
+    while (node != nullptr) {
+      //  node->key < key
+      if (Less(node->key, key)) {
+        node = node->right;
+      } else {
+        bound = node;
+        node = node->left;
       }
     }
-    return it;
+    return iterator(bound);
+  }
+
+  //  First key greater than `key`
+  iterator upper_bound(const Key &key) {
+    Node *node = root_;
+    Node *bound = nullptr;
+    while (node != nullptr) {
+      //  key < node->key
+      if (Less(key, node->key)) {
+        bound = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return iterator(bound);
   }
 
   template <typename... Args>
   vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
     s21::vector<std::pair<iterator, bool>> results;
-    for (const auto &arg : {args...}) {
-      auto result = insert(arg);
-      results.push_back(result);
-    }
+    results.reserve(sizeof...(args));
+    (results.push_back(insert(std::forward<Args>(args))), ...);
     return results;
   }
 
+  //  Number of levels, 0 for an empty tree
+  size_type height() const {
+    size_type result = 0;
+    VisitDepths([&result](size_type depth) {
+      result = std::max(result, depth);
+    });
+    return result;
+  }
+
+  //  Element i counts the nodes on level i, the root is on level 0
+  s21::vector<size_type> depth_histogram() const {
+    s21::vector<size_type> levels(height());
+    VisitDepths([&levels](size_type depth) { ++levels[depth - 1]; });
+    return levels;
+  }
+
+  //  Mean number of nodes visited by a successful search
+  double average_path_length() const {
+    size_type total = 0;
+    VisitDepths([&total](size_type depth) { total += depth; });
+    return size_ ? double(total) / size_ : 0.0;
+  }
+
+  //  Writes the shape figures above as a single JSON object
+  void dump_stats(std::ostream &out) const {
+    s21::vector<size_type> levels = depth_histogram();
+    out << "{\"size\":" << size_ << ",\"height\":" << levels.size()
+        << ",\"average_path_length\":" << average_path_length()
+        << ",\"depth_histogram\":[";
+    for (size_type i = 0; i < levels.size(); ++i) {
+      out << (i ? "," : "") << levels[i];
+    }
+    out << "],\"counters\":";
+    dump_tree_counters(out);
+    out << "}";
+  }
+
+  //  Moves every key not less than `key` into `right`, this keeps the rest.
+  //  O(h) plus counting the smaller of the two halves.
+  void split(const Key &key, BinaryTree &right) {
+    right.clear();
+    Node *equal{};
+    size_type total = size_;
+    try {
+      SplitNode(root_, key, &root_, &right.root_, &equal);
+    } catch (...) {
+      ResetBounds();
+      throw;
+    }
+    right.root_ = JoinNodes(equal, right.root_);
+    ResetBounds();
+    right.ResetBounds();
+    right.size_ = SecondSize(leftmost_, right.leftmost_, total);
+    size_ = total - right.size_;
+  }
+
+  //  Appends `right`, whose keys must all be greater than ours, in O(h)
+  void join(BinaryTree &right) {
+    root_ = JoinNodes(root_, right.root_);
+    size_ += right.size_;
+    right.root_ = right.leftmost_ = right.rightmost_ = nullptr;
+    right.size_ = 0;
+    ResetBounds();
+  }
+
+  //  Fork-join set algebra, `other` is consumed like in merge(). On equal
+  //  keys ours is kept. If the comparator throws, both trees stay valid and
+  //  keep every key not freed yet, though some of `other` may have moved
+  //  over. Forked tasks free nodes concurrently, hence the allocator must
+  //  be stateless.
+  void set_union(BinaryTree &other) {
+    static_assert(!Multi, "set algebra needs unique keys");
+    static_assert(kStatelessAllocator, "forked tasks share the allocator");
+    size_type depth = ForkDepth(other.size_);
+    try {
+      size_ += other.size_ - UnionNodes(&root_, &other.root_, depth);
+    } catch (...) {
+      Resync();
+      other.Resync();
+      throw;
+    }
+    other.size_ = 0;
+    other.ResetBounds();
+    ResetBounds();
+  }
+
+  void set_intersection(BinaryTree &other) {
+    static_assert(!Multi, "set algebra needs unique keys");
+    static_assert(kStatelessAllocator, "forked tasks share the allocator");
+    size_type depth = ForkDepth(other.size_);
+    try {
+      size_ = IntersectNodes(&root_, &other.root_, depth);
+    } catch (...) {
+      Resync();
+      other.Resync();
+      throw;
+    }
+    other.size_ = 0;
+    other.ResetBounds();
+    ResetBounds();
+  }
+
+  void set_difference(BinaryTree &other) {
+    static_assert(!Multi, "set algebra needs unique keys");
+    static_assert(kStatelessAllocator, "forked tasks share the allocator");
+    size_type depth = ForkDepth(other.size_);
+    try {
+      size_ -= DifferenceNodes(&root_, &other.root_, depth);
+    } catch (...) {
+      Resync();
+      other.Resync();
+      throw;
+    }
+    other.size_ = 0;
+    other.ResetBounds();
+    ResetBounds();
+  }
+
+  //  Sorts the range in parallel, builds a treap of it and unions it in
+  template <class ForwardIt>
+  void bulk_insert(ForwardIt first, ForwardIt last) {
+    static_assert(!Multi, "set algebra needs unique keys");
+    size_type count = std::distance(first, last);
+    if (count == 0) {
+      return;
+    }
+    s21::vector<const Key *> keys(count);
+    for (size_type i = 0; first != last; ++first, ++i) {
+      keys[i] = &*first;
+    }
+    SortKeys(keys.data(), keys.data() + count, ForkDepth(count));
+    BinaryTree other;
+    s21::vector<Node *> nodes(count);
+    size_type unique = 0;
+    try {
+      for (size_type i = 0; i < count; ++i) {
+        if (i == 0 || Less(*keys[i - 1], *keys[i])) {
+          nodes[unique] = other.NewNode(*keys[i]);
+          ++unique;
+        }
+      }
+      other.root_ = BuildTreap(nodes.data(), nodes.data() + unique);
+    } catch (...) {
+      for (size_type i = 0; i < unique; ++i) other.DealocNode(nodes[i]);
+      throw;
+    }
+    other.ResetBounds();
+    set_union(other);
+  }
+
  protected:
   //  Tree root_
   Node *root_{};
+  //  Cached ends, so begin(), front() and pop_min() skip the descent
+  Node *leftmost_{};
+  Node *rightmost_{};
   allocator_type allocator_{};
   size_type size_{};
-  bool Less(Key a, Key b, Compare cmp = Compare{}) { return cmp(a, b); }
+  bool Less(const Key &a, const Key &b, Compare cmp = Compare{}) {
+    S21_TREE_COUNT(comparisons);
+    return cmp(a, b);
+  }
 
-  void erase(Node *node, Node *&root_) {
-    if (node == nullptr) {
-      return;
+  static Node *Leftmost(Node *node) {
+    if (node != nullptr) {
+      while (node->left != nullptr) node = node->left;
     }
-    Node *parent = nullptr;
-    Node *current = root_;
-    while (current != nullptr && current->key != node->key) {
-      parent = current;
-      // node->key < current->key
-      if (Less(node->key, current->key)) {
-        current = current->left;
-      } else {
-        current = current->right;
+    return node;
+  }
+
+  static Node *Rightmost(Node *node) {
+    if (node != nullptr) {
+      while (node->right != nullptr) node = node->right;
+    }
+    return node;
+  }
+
+  //  The node behind an iterator, for derived containers
+  static Node *NodeOf(const_iterator pos) { return pos.current_node_; }
+
+  //  In-order successor, walks up through the parent links
+  static Node *Next(Node *node) {
+    if (node->right != nullptr) {
+      return Leftmost(node->right);
+    }
+    Node *parent = node->parent;
+    while (parent != nullptr && parent->right == node) {
+      node = parent;
+      parent = parent->parent;
+    }
+    return parent;
+  }
+
+  static Node *Prev(Node *node) {
+    if (node->left != nullptr) {
+      return Rightmost(node->left);
+    }
+    Node *parent = node->parent;
+    while (parent != nullptr && parent->left == node) {
+      node = parent;
+      parent = parent->parent;
+    }
+    return parent;
+  }
+
+  static void SetParent(Node *child, Node *parent) {
+    if (child != nullptr) child->parent = parent;
+  }
+
+  //  Recomputes the cached ends after the tree was rebuilt wholesale
+  void ResetBounds() {
+    SetParent(root_, nullptr);
+    leftmost_ = Leftmost(root_);
+    rightmost_ = Rightmost(root_);
+  }
+
+  //  Recounts after set algebra threw part way through, O(n)
+  void Resync() {
+    ResetBounds();
+    size_ = CountNodes(root_);
+  }
+
+  //  Copies of such an allocator are interchangeable, so forked tasks can
+  //  free nodes through it at the same time
+  static constexpr bool kStatelessAllocator =
+      std::allocator_traits<allocator_type>::is_always_equal::value;
+
+  //  xorshift32 per thread. Priorities are drawn, not derived from the
+  //  node address: freed nodes come back in heap order, and sorted runs
+  //  built from them would inherit it.
+  static std::uint32_t NextPriority() {
+    thread_local std::uint32_t state = static_cast<std::uint32_t>(
+        0x9E3779B9u ^ reinterpret_cast<std::uintptr_t>(&state));
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+
+  //  Lifts `node` above its parent, keeping the key order
+  void RotateUp(Node *node) {
+    Node *parent = node->parent;
+    if (parent->left == node) {
+      parent->left = node->right;
+      SetParent(node->right, parent);
+      node->right = parent;
+    } else {
+      parent->right = node->left;
+      SetParent(node->left, parent);
+      node->left = parent;
+    }
+    Transplant(parent, node);
+    parent->parent = node;
+  }
+
+  //  Below this many keys a fork costs more than it saves
+  static constexpr size_type kForkGrain = 1 << 14;
+
+  //  Recursion depth up to which set algebra spawns tasks, 0 means serial
+  static size_type ForkDepth(size_type work) {
+    if (work < kForkGrain) {
+      return 0;
+    }
+    size_type threads = std::thread::hardware_concurrency();
+    size_type depth = 2;
+    while (threads > 1) {
+      threads >>= 1;
+      ++depth;
+    }
+    return depth;
+  }
+
+  //  Runs `left` on its own thread while this one runs `right`. A forked
+  //  `left` always runs to the end before an exception of either side is
+  //  rethrown; a serial one is skipped once `right` has thrown.
+  template <class LeftFn, class RightFn>
+  static auto ForkJoin(size_type depth, LeftFn left, RightFn right)
+      -> std::pair<decltype(left()), decltype(right())> {
+    std::future<decltype(left())> job;
+    if (depth > 0) {
+      try {
+        job = std::async(std::launch::async, left);
+      } catch (const std::system_error &) {
+        //  Out of threads, finish this branch serially
       }
     }
-    if (current == nullptr) {
-      return;
+    std::exception_ptr error;
+    decltype(right()) right_result{};
+    try {
+      right_result = right();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    decltype(left()) left_result{};
+    if (job.valid()) {
+      try {
+        left_result = job.get();
+      } catch (...) {
+        if (!error) error = std::current_exception();
+      }
+    } else if (!error) {
+      left_result = left();
     }
-    RouteTree(current, parent);
+    if (error) std::rethrow_exception(error);
+    return std::make_pair(left_result, right_result);
   }
 
-  void RouteTree(Node *current, Node *parent) {
-    if (current->left == nullptr && current->right == nullptr) {
-      if (current == root_) {
-        root_ = nullptr;
-      } else if (parent->left == current) {
-        parent->left = nullptr;
-      } else {
-        parent->right = nullptr;
+  //  left < key <= right, an equal node is detached into `equal`. With
+  //  Multi all equal keys stay in `right` and `equal` is left untouched.
+  //  One walk down the search path: each node is hung on the open link of
+  //  the side it belongs to, and that side's link moves into the node, so
+  //  both sides keep heap order. If a comparison throws, every node is
+  //  joined back into *left and *right is null.
+  void SplitNode(Node *node, const Key &key, Node **left, Node **right,
+                 Node **equal) {
+    Node **left_root = left, **right_root = right;
+    Node *left_parent{}, *right_parent{};
+    try {
+      while (node != nullptr) {
+        //  key < node->key
+        if (Less(key, node->key) || (Multi && !Less(node->key, key))) {
+          *right = node;
+          node->parent = right_parent;
+          right_parent = node;
+          right = &node->left;
+          node = node->left;
+          //  node->key < key
+        } else if (Less(node->key, key)) {
+          *left = node;
+          node->parent = left_parent;
+          left_parent = node;
+          left = &node->right;
+          node = node->right;
+        } else {
+          *left = node->left;
+          SetParent(node->left, left_parent);
+          *right = node->right;
+          SetParent(node->right, right_parent);
+          node->left = node->right = nullptr;
+          *equal = node;
+          return;
+        }
       }
-      DealocNode(current);
-    } else if (current->right == nullptr) {
-      if (current == root_) {
-        root_ = current->left;
-      } else if (parent->left == current) {
-        parent->left = current->left;
+    } catch (...) {
+      //  The unsplit rest lies between the two sides
+      *left = node;
+      SetParent(node, left_parent);
+      *right = nullptr;
+      *left_root = JoinNodes(*left_root, *right_root);
+      *right_root = nullptr;
+      throw;
+    }
+    *left = *right = nullptr;
+  }
+
+  //  Size of the tree starting at `second`, given the total with the tree
+  //  starting at `first`. Both are walked in step, so only the smaller one
+  //  is counted.
+  static size_type SecondSize(Node *first, Node *second, size_type total) {
+    size_type steps = 0;
+    while (first != nullptr && second != nullptr) {
+      first = Next(first);
+      second = Next(second);
+      ++steps;
+    }
+    return first == nullptr ? total - steps : steps;
+  }
+
+  //  Every key of `left` is less than every key of `right`. Zips the right
+  //  spine of one with the left spine of the other by priority, O(h).
+  static Node *JoinNodes(Node *left, Node *right) {
+    Node *root{};
+    Node **link = &root;
+    Node *parent{};
+    while (left != nullptr && right != nullptr) {
+      if (left->priority >= right->priority) {
+        *link = left;
+        left->parent = parent;
+        parent = left;
+        link = &left->right;
+        left = left->right;
       } else {
-        parent->right = current->left;
+        *link = right;
+        right->parent = parent;
+        parent = right;
+        link = &right->left;
+        right = right->left;
       }
-      DealocNode(current);
-    } else if (current->left == nullptr) {
-      if (current == root_) {
-        root_ = current->right;
-      } else if (parent->left == current) {
-        parent->left = current->right;
+    }
+    *link = left != nullptr ? left : right;
+    SetParent(*link, parent);
+    return root;
+  }
+
+  //  Joins `left`, the lone node `middle`, which may be null, and `right`
+  static Node *JoinAround(Node *left, Node *middle, Node *right) {
+    if (middle == nullptr) return JoinNodes(left, right);
+    if ((left == nullptr || left->priority <= middle->priority) &&
+        (right == nullptr || right->priority <= middle->priority)) {
+      middle->left = left;
+      middle->right = right;
+      SetParent(left, middle);
+      SetParent(right, middle);
+      middle->parent = nullptr;
+      return middle;
+    }
+    middle->left = middle->right = nullptr;
+    return JoinNodes(JoinNodes(left, middle), right);
+  }
+
+  //  The recursions below take their two trees by pointer. On success *a
+  //  holds the result and *b is null. If a comparison throws, *a and *b
+  //  are left as valid trees holding every node not freed yet and the
+  //  exception propagates; finished subtrees keep their result in *a.
+
+  //  Returns the number of duplicates freed from b. The root of higher
+  //  priority stays on top, the other tree is split around it.
+  size_type UnionNodes(Node **a, Node **b, size_type depth) {
+    if (*a == nullptr) std::swap(*a, *b);
+    if (*b == nullptr) return 0;
+    bool a_top = (*a)->priority >= (*b)->priority;
+    Node *top = a_top ? *a : *b;
+    Node *left{}, *right{}, *equal{};
+    Node *top_left = top->left, *top_right = top->right;
+    Node *&a_left = a_top ? top_left : left;
+    Node *&a_right = a_top ? top_right : right;
+    Node *&b_left = a_top ? left : top_left;
+    Node *&b_right = a_top ? right : top_right;
+    size_type next = depth ? depth - 1 : 0;
+    std::pair<size_type, size_type> freed;
+    try {
+      SplitNode(a_top ? *b : *a, top->key, &left, &right, &equal);
+      freed = ForkJoin(
+          depth, [&] { return UnionNodes(&a_left, &b_left, next); },
+          [&] { return UnionNodes(&a_right, &b_right, next); });
+    } catch (...) {
+      *a = JoinAround(a_left, a_top ? top : equal, a_right);
+      *b = JoinAround(b_left, a_top ? equal : top, b_right);
+      throw;
+    }
+    Node *root = top;
+    if (equal != nullptr) {
+      //  Our key wins; it takes the place and priority of the other's node
+      Node *loser = a_top ? equal : top;
+      root = a_top ? top : equal;
+      root->priority = top->priority;
+      DestroyNode(loser);
+    }
+    root->left = a_left;
+    root->right = a_right;
+    SetParent(root->left, root);
+    SetParent(root->right, root);
+    *a = root;
+    *b = nullptr;
+    return (equal != nullptr) + freed.first + freed.second;
+  }
+
+  //  Returns the number of keys left in a; the result keeps a's shape
+  size_type IntersectNodes(Node **a, Node **b, size_type depth) {
+    if (*a == nullptr || *b == nullptr) {
+      DestroySubtree(*a);
+      DestroySubtree(*b);
+      *a = *b = nullptr;
+      return 0;
+    }
+    Node *top = *a;
+    Node *a_left = top->left, *a_right = top->right;
+    Node *b_left{}, *b_right{}, *equal{};
+    size_type next = depth ? depth - 1 : 0;
+    std::pair<size_type, size_type> kept;
+    try {
+      SplitNode(*b, top->key, &b_left, &b_right, &equal);
+      kept = ForkJoin(
+          depth, [&] { return IntersectNodes(&a_left, &b_left, next); },
+          [&] { return IntersectNodes(&a_right, &b_right, next); });
+    } catch (...) {
+      *a = JoinAround(a_left, top, a_right);
+      *b = JoinAround(b_left, equal, b_right);
+      throw;
+    }
+    *b = nullptr;
+    if (equal == nullptr) {
+      DestroyNode(top);
+      *a = JoinNodes(a_left, a_right);
+      return kept.first + kept.second;
+    }
+    DestroyNode(equal);
+    top->left = a_left;
+    top->right = a_right;
+    SetParent(top->left, top);
+    SetParent(top->right, top);
+    return kept.first + kept.second + 1;
+  }
+
+  //  Returns the number of keys removed from a; follows b's shape
+  size_type DifferenceNodes(Node **a, Node **b, size_type depth) {
+    if (*a == nullptr || *b == nullptr) {
+      DestroySubtree(*b);
+      *b = nullptr;
+      return 0;
+    }
+    Node *top = *b;
+    Node *b_left = top->left, *b_right = top->right;
+    Node *a_left{}, *a_right{}, *equal{};
+    size_type next = depth ? depth - 1 : 0;
+    std::pair<size_type, size_type> removed;
+    try {
+      SplitNode(*a, top->key, &a_left, &a_right, &equal);
+      removed = ForkJoin(
+          depth, [&] { return DifferenceNodes(&a_left, &b_left, next); },
+          [&] { return DifferenceNodes(&a_right, &b_right, next); });
+    } catch (...) {
+      *a = JoinAround(a_left, equal, a_right);
+      *b = JoinAround(b_left, top, b_right);
+      throw;
+    }
+    DestroyNode(top);
+    if (equal != nullptr) DestroyNode(equal);
+    *a = JoinNodes(a_left, a_right);
+    *b = nullptr;
+    return (equal != nullptr) + removed.first + removed.second;
+  }
+
+  void SortKeys(const Key **first, const Key **last, size_type depth) {
+    auto less = [this](const Key *a, const Key *b) { return Less(*a, *b); };
+    if (depth == 0 || last - first < difference_type{kForkGrain}) {
+      std::sort(first, last, less);
+      return;
+    }
+    const Key **middle = first + (last - first) / 2;
+    ForkJoin(
+        depth, [&] { return SortKeys(first, middle, depth - 1), 0; },
+        [&] { return SortKeys(middle, last, depth - 1), 0; });
+    std::inplace_merge(first, middle, last, less);
+  }
+
+  //  Links an already sorted run of nodes into the one treap their
+  //  priorities allow, O(n) with a stack of the right spine
+  static Node *BuildTreap(Node **first, Node **last) {
+    s21::vector<Node *> spine;
+    spine.reserve(last - first);
+    Node *root{};
+    for (; first != last; ++first) {
+      Node *node = *first;
+      Node *below{};
+      while (!spine.empty() && spine.back()->priority < node->priority) {
+        below = spine.back();
+        spine.pop_back();
+      }
+      node->left = below;
+      node->right = nullptr;
+      SetParent(below, node);
+      if (spine.empty()) {
+        node->parent = nullptr;
+        root = node;
       } else {
-        parent->right = current->right;
+        spine.back()->right = node;
+        node->parent = spine.back();
       }
-      DealocNode(current);
-    } else {
-      Node *successorParent = current;
-      Node *successor = current->right;
-      RestructTree(successorParent, successor, current, parent);
+      spine.push_back(node);
     }
+    return root;
   }
 
-  void RestructTree(Node *successorParent, Node *successor, Node *current,
-                    Node *parent) {
-    while (successor->left != nullptr) {
-      successorParent = successor;
-      successor = successor->left;
+  //  Calls fn(depth) for every node, iterative so any shape is fine
+  template <class Fn>
+  void VisitDepths(Fn fn) const {
+    if (root_ == nullptr) return;
+    s21::stack<std::pair<Node *, size_type>> pending;
+    pending.push(std::make_pair(root_, size_type{1}));
+    while (!pending.empty()) {
+      std::pair<Node *, size_type> item = pending.top();
+      pending.pop();
+      fn(item.second);
+      if (item.first->left != nullptr) {
+        pending.push(std::make_pair(item.first->left, item.second + 1));
+      }
+      if (item.first->right != nullptr) {
+        pending.push(std::make_pair(item.first->right, item.second + 1));
+      }
     }
-    if (successorParent != current) {
-      successorParent->left = successor->right;
-      successor->right = current->right;
+  }
+
+  static size_type CountNodes(Node *node) {
+    size_type count = 0;
+    if (node == nullptr) return count;
+    s21::stack<Node *> pending;
+    pending.push(node);
+    while (!pending.empty()) {
+      Node *top = pending.top();
+      pending.pop();
+      ++count;
+      if (top->left != nullptr) pending.push(top->left);
+      if (top->right != nullptr) pending.push(top->right);
     }
-    if (current == root_) {
-      root_ = successor;
-    } else if (parent->left == current) {
-      parent->left = successor;
+    return count;
+  }
+
+  //  Puts `to` where `from` hangs, `from` keeps its own children
+  void Transplant(Node *from, Node *to) {
+    if (from->parent == nullptr) {
+      root_ = to;
+    } else if (from->parent->left == from) {
+      from->parent->left = to;
     } else {
-      parent->right = successor;
+      from->parent->right = to;
+    }
+    SetParent(to, from->parent);
+  }
+
+  //  Detaches a node from the tree without freeing it. The node is rotated
+  //  down past its higher priority child until one side is empty.
+  void Unlink(Node *current) {
+    if (current == leftmost_) leftmost_ = Next(current);
+    if (current == rightmost_) rightmost_ = Prev(current);
+    while (current->left != nullptr && current->right != nullptr) {
+      RotateUp(current->left->priority > current->right->priority
+                   ? current->left
+                   : current->right);
+    }
+    Transplant(current,
+               current->left != nullptr ? current->left : current->right);
+  }
+
+  //  Hangs a new node under `parent`, updating the cached ends, and lifts
+  //  it back into heap order
+  void Attach(Node *node, Node *parent, Node **link) {
+    *link = node;
+    node->parent = parent;
+    if (parent == nullptr || leftmost_->left == node) leftmost_ = node;
+    if (parent == nullptr || rightmost_->right == node) rightmost_ = node;
+    while (node->parent != nullptr && node->parent->priority < node->priority) {
+      RotateUp(node);
     }
-    successor->left = current->left;
-    DealocNode(current);
   }
 
+  //  Clones the shape of another tree node by node, O(n) and iterative
   void CopyTree(Node *node) {
-    if (node != NULL) {
-      CopyTree(node->left);
-      CopyTree(node->right);
-      insert(node->key);
+    if (node == nullptr) return;
+    try {
+      root_ = NewNode(node->key);
+      root_->priority = node->priority;
+      Node *copy = root_;
+      Node *source = node;
+      while (source != nullptr) {
+        if (source->left != nullptr && copy->left == nullptr) {
+          copy->left = NewNode(source->left->key);
+          copy->left->priority = source->left->priority;
+          copy->left->parent = copy;
+          source = source->left;
+          copy = copy->left;
+        } else if (source->right != nullptr && copy->right == nullptr) {
+          copy->right = NewNode(source->right->key);
+          copy->right->priority = source->right->priority;
+          copy->right->parent = copy;
+          source = source->right;
+          copy = copy->right;
+        } else {
+          source = (source == node) ? nullptr : source->parent;
+          copy = copy->parent;
+        }
+      }
+    } catch (...) {
+      clear();
+      throw;
     }
+    ResetBounds();
   }
 
   void DealocNode(Node *node) {
+    DestroyNode(node);
+    size_--;
+  }
+
+  //  Frees a node without touching size_, safe to call from forked tasks
+  void DestroyNode(Node *node) {
+    S21_TREE_COUNT(node_deallocations);
     std::allocator_traits<allocator_type>::destroy(allocator_, node);
     std::allocator_traits<allocator_type>::deallocate(allocator_, node, 1);
-    size_--;
   }
-  //  Tree full cleanup
+
+  void DestroySubtree(Node *node) {
+    Node *top = node != nullptr ? node->parent : nullptr;
+    while (node != top) {
+      if (node->left != nullptr) {
+        node = node->left;
+        node->parent->left = nullptr;
+      } else if (node->right != nullptr) {
+        node = node->right;
+        node->parent->right = nullptr;
+      } else {
+        Node *parent = node->parent;
+        DestroyNode(node);
+        node = parent;
+      }
+    }
+  }
+  //  Tree full cleanup, iterative so degenerate trees cannot overflow
   void DestroyTree(Node *node) {
-    if (node != NULL) {
-      DestroyTree(node->left);
-      DestroyTree(node->right);
-      DealocNode(node);
+    while (node != nullptr) {
+      if (node->left != nullptr) {
+        node = node->left;
+        node->parent->left = nullptr;
+      } else if (node->right != nullptr) {
+        node = node->right;
+        node->parent->right = nullptr;
+      } else {
+        Node *parent = node->parent;
+        DealocNode(node);
+        node = parent;
+      }
     }
   }
 
-  Node *NewNode(const Key &key) {
+  template <class... Args>
+  Node *NewNode(Args &&...args) {
+    S21_TREE_COUNT(node_allocations);
     Node *new_node =
         std::allocator_traits<allocator_type>::allocate(allocator_, 1);
-    std::allocator_traits<allocator_type>::construct(allocator_, new_node, key);
+    try {
+      std::allocator_traits<allocator_type>::construct(
+          allocator_, new_node, std::forward<Args>(args)...);
+    } catch (...) {
+      std::allocator_traits<allocator_type>::deallocate(allocator_, new_node,
+                                                        1);
+      throw;
+    }
+    new_node->priority = NextPriority();
     size_++;
     return new_node;
   }
 
-  Node *Search(Key key) { return Search(root_, key); }
+  //  Finds where `key` belongs. Returns the equal node if there is one and
+  //  the tree is not Multi; otherwise null with `parent`/`link` filled in.
+  Node *FindLink(const Key &key, Node **parent, Node ***link) {
+    *parent = nullptr;
+    *link = &root_;
+    while (**link != nullptr) {
+      Node *node = **link;
+      //  key < node->key
+      if (Less(key, node->key)) {
+        *parent = node;
+        *link = &node->left;
+        //  node->key < key, equal keys go right in a Multi tree
+      } else if (Multi || Less(node->key, key)) {
+        *parent = node;
+        *link = &node->right;
+      } else {
+        return node;
+      }
+    }
+    return nullptr;
+  }
 
-  Node *Search(Node *node, const Key &key) {
-    if (node == nullptr) return nullptr;
-    //  node->key == key
-    if (!Less(key, node->key) && !Less(node->key, key)) return node;
-    //  key < node->key
-    if (Less(key, node->key))
-      return Search(node->left, key);
-    else
-      return Search(node->right, key);
+  //  Like FindLink, but tries the slot right before `hint` first
+  Node *FindHintLink(Node *hint, const Key &key, Node **parent,
+                     Node ***link) {
+    Node *prev = (hint == nullptr) ? rightmost_ : Prev(hint);
+    //  prev < key < hint, equal neighbours are fine in a Multi tree
+    bool after_prev = prev == nullptr ||
+                      (Multi ? !Less(key, prev->key) : Less(prev->key, key));
+    bool before_hint = hint == nullptr ||
+                       (Multi ? !Less(hint->key, key) : Less(key, hint->key));
+    if (root_ == nullptr || !after_prev || !before_hint) {
+      return FindLink(key, parent, link);
+    }
+    //  One of the two slots between prev and hint is always free
+    if (hint != nullptr && (prev == nullptr || prev->right != nullptr)) {
+      *parent = hint;
+      *link = &hint->left;
+    } else {
+      *parent = prev;
+      *link = &prev->right;
+    }
+    return nullptr;
   }
 
-  Node *InsertIt(Node *node, const Key &key, Node **insert) {
-    if (node == nullptr) {
-      Node *tmp = NewNode(key);
-      *insert = tmp;
-      return tmp;
+  //  Links a detached node, false if its key is already present
+  bool InsertNode(Node *node) {
+    Node *parent{};
+    Node **link{};
+    if (FindLink(node->key, &parent, &link) != nullptr) {
+      return false;
     }
-    //  key < node->key
-    if (Less(key, node->key)) {
-      node->left = InsertIt(node->left, key, insert);
-      //  key >= node->key
-    } else if (Less(node->key, key)) {
-      node->right = InsertIt(node->right, key, insert);
+    node->left = node->right = nullptr;
+    Attach(node, parent, link);
+    return true;
+  }
+
+  //  Relinks the nodes of another tree into this one without copying keys.
+  //  Takes the smallest node of the other tree each time, which has no left
+  //  child and is spliced out in O(1), so any shape is walked without a
+  //  stack. Keys arrive in order: while a key stays below `bound`, the
+  //  first node here greater than the previous key, it is linked right
+  //  between `last` and `bound` without a search.
+  void MergeNodes(Node *node) {
+    Node *last{};
+    Node *bound = leftmost_;
+    while (node != nullptr) {
+      Node *parent = node->parent;
+      Node *right = node->right;
+      if (parent != nullptr) parent->left = right;
+      SetParent(right, parent);
+      Node *next = right != nullptr ? Leftmost(right) : parent;
+
+      Node *link_parent{};
+      Node **link{};
+      Node *found{};
+      bool searched = bound != nullptr && !Less(node->key, bound->key);
+      if (searched) {
+        //  Equal keys go after the ones already here, as with FindLink
+        found = FindLink(node->key, &link_parent, &link);
+      } else if (last != nullptr && last->right == nullptr) {
+        link_parent = last;
+        link = &last->right;
+      } else {
+        //  One of the two slots between adjacent nodes is always free
+        link_parent = bound;
+        link = &bound->left;
+      }
+      if (found != nullptr) {
+        DestroyNode(node);
+        node = found;
+      } else {
+        node->left = node->right = nullptr;
+        Attach(node, link_parent, link);
+        size_++;
+      }
+      if (searched) bound = Next(node);
+      last = node;
+      node = next;
+    }
+  }
+
+  Node *Search(const Key &key) {
+    Node *node = root_;
+    while (node != nullptr) {
+      //  key < node->key
+      if (Less(key, node->key)) {
+        node = node->left;
+        //  node->key < key
+      } else if (Less(node->key, key)) {
+        node = node->right;
+      } else {
+        break;
+      }
+    }
+    return node;
+  }
+
+  //  The key is forwarded into the new node only once a free leaf is found,
+  //  returns null if it was already present
+  template <class K>
+  Node *InsertIt(K &&key) {
+    Node *parent{};
+    Node **link{};
+    if (FindLink(key, &parent, &link) != nullptr) {
+      return nullptr;
+    }
+    Node *node = NewNode(std::forward<K>(key));
+    Attach(node, parent, link);
+    return node;
+  }
+
+  //  Returns the new node, or the one already holding the key
+  template <class K>
+  Node *InsertHint(Node *hint, K &&key) {
+    Node *parent{};
+    Node **link{};
+    Node *found = FindHintLink(hint, key, &parent, &link);
+    if (found != nullptr) {
+      return found;
     }
+    Node *node = NewNode(std::forward<K>(key));
+    Attach(node, parent, link);
     return node;
   }
 
@@ -0,0 +1,610 @@
+#ifndef CONTAINERS_SRC_S21_COMPACT_TREE_H_
+#define CONTAINERS_SRC_S21_COMPACT_TREE_H_
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "s21_map.h"
+#include "s21_vector.h"
+
+namespace s21 {
+//  Binary search tree whose nodes live in one contiguous arena and link to
+//  each other with 32-bit indices instead of pointers. Holds up to 2^32 - 2
+//  keys; erased slots are recycled through a free list.
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
+class CompactTree {
+ public:
+  class Node;
+  template <bool Const>
+  class CompactIterator;
+  using index_type = std::uint32_t;
+  using iterator = CompactIterator<false>;
+  using const_iterator = CompactIterator<true>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using allocator_traits = std::allocator_traits<allocator_type>;
+
+  static constexpr index_type kNil = std::numeric_limits<index_type>::max();
+
+  class Node {
+   public:
+    Key key;
+    index_type left = kNil;
+    index_type right = kNil;
+    index_type parent = kNil;
+    template <class... Args>
+    explicit Node(Args &&...args) : key(std::forward<Args>(args)...) {}
+  };  //  class Node
+
+  template <bool Const>
+  class CompactIterator {
+    friend class CompactTree;
+    using tree_pointer =
+        std::conditional_t<Const, const CompactTree *, CompactTree *>;
+
+   public:
+    using value_type = Key;
+    using pointer = std::conditional_t<Const, const Key *, Key *>;
+    using reference = std::conditional_t<Const, const Key &, Key &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    CompactIterator(tree_pointer tree, index_type index)
+        : tree_(tree), index_(index) {}
+    //  iterator -> const_iterator
+    template <bool C = Const, class = std::enable_if_t<C>>
+    CompactIterator(const CompactIterator<false> &other)
+        : tree_(other.tree_), index_(other.index_) {}
+
+    reference operator*() const { return tree_->nodes_[index_].key; }
+    pointer operator->() const { return &(tree_->nodes_[index_].key); }
+    bool operator==(const CompactIterator &other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const CompactIterator &other) const {
+      return index_ != other.index_;
+    }
+
+    CompactIterator &operator++() {
+      index_ = tree_->Next(index_);
+      return *this;
+    }
+    CompactIterator operator++(int) {
+      CompactIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+   private:
+    template <bool>
+    friend class CompactIterator;
+    tree_pointer tree_;
+    index_type index_;
+  };  //  class CompactIterator
+
+  CompactTree() {}
+  CompactTree(std::initializer_list<Key> const &items) : CompactTree() {
+    try {
+      reserve(items.size());
+      for (auto it = items.begin(); it != items.end(); it++) {
+        insert(*it);
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+  CompactTree(const CompactTree &other) { CopyTree(other); }
+  CompactTree(CompactTree &&other) noexcept { swap(other); }
+  ~CompactTree() {
+    clear();
+    allocator_traits::deallocate(allocator_, nodes_, capacity_);
+  }
+
+  CompactTree &operator=(const CompactTree &other) {
+    if (this != &other) {
+      CompactTree copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  CompactTree &operator=(CompactTree &&other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  //  Destroys every key but keeps the arena for reuse
+  void clear() {
+    DestroyTree(root_);
+    root_ = free_ = kNil;
+    used_ = 0;
+    size_ = 0;
+  }
+
+  void reserve(size_type count) {
+    if (count > max_size()) {
+      throw std::length_error("CompactTree::reserve");
+    }
+    if (count <= capacity_) {
+      return;
+    }
+    if (free_ == kNil) {
+      Grow(static_cast<index_type>(count));
+    } else {
+      Compact(static_cast<index_type>(count));
+    }
+  }
+
+  iterator begin() { return iterator(this, Leftmost(root_)); }
+  iterator end() { return iterator(this, kNil); }
+  const_iterator begin() const { return const_iterator(this, Leftmost(root_)); }
+  const_iterator end() const { return const_iterator(this, kNil); }
+  bool empty() const { return root_ == kNil; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    size_type arena = allocator_traits::max_size(allocator_);
+    return arena < kNil ? arena : size_type{kNil} - 1;
+  }
+  //  Bytes held by the arena, including recycled slots
+  size_type memory_usage() const { return capacity_ * sizeof(Node); }
+
+  bool contains(const Key &key) const { return Search(key) != kNil; }
+
+  iterator find(const Key &key) { return iterator(this, Search(key)); }
+  const_iterator find(const Key &key) const {
+    return const_iterator(this, Search(key));
+  }
+
+  std::pair<iterator, bool> insert(const Key &value) { return InsertIt(value); }
+  std::pair<iterator, bool> insert(Key &&value) {
+    return InsertIt(std::move(value));
+  }
+
+  void erase(iterator pos) {
+    if (pos.index_ != kNil) {
+      Unlink(pos.index_);
+      DealocNode(pos.index_);
+    }
+  }
+
+  void merge(CompactTree &other) {
+    if (other.root_ == kNil) {
+      return;
+    }
+    if (root_ == kNil) {
+      this->swap(other);
+    } else {
+      for (auto it = other.begin(); it != other.end(); ++it) {
+        this->insert(*it);
+      }
+      other.clear();
+    }
+  }
+
+  void swap(CompactTree &other) noexcept {
+    std::swap(nodes_, other.nodes_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(used_, other.used_);
+    std::swap(free_, other.free_);
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(allocator_, other.allocator_);
+  }
+
+  template <typename... Args>
+  vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    vector<std::pair<iterator, bool>> results;
+    results.reserve(sizeof...(args));
+    (results.push_back(insert(std::forward<Args>(args))), ...);
+    return results;
+  }
+
+ protected:
+  Node *nodes_{};
+  index_type capacity_{};
+  //  Slots below used_ have been handed out at least once
+  index_type used_{};
+  //  Head of the recycled slot list, threaded through the slots themselves
+  index_type free_ = kNil;
+  index_type root_ = kNil;
+  size_type size_{};
+  allocator_type allocator_{};
+
+  bool Less(const Key &a, const Key &b) const { return Compare{}(a, b); }
+
+  Node &At(index_type index) { return nodes_[index]; }
+  const Node &At(index_type index) const { return nodes_[index]; }
+
+  index_type Leftmost(index_type index) const {
+    if (index == kNil) return kNil;
+    while (nodes_[index].left != kNil) index = nodes_[index].left;
+    return index;
+  }
+
+  index_type Next(index_type index) const {
+    if (nodes_[index].right != kNil) {
+      return Leftmost(nodes_[index].right);
+    }
+    index_type parent = nodes_[index].parent;
+    while (parent != kNil && nodes_[parent].right == index) {
+      index = parent;
+      parent = nodes_[parent].parent;
+    }
+    return parent;
+  }
+
+  index_type Search(const Key &key) const {
+    index_type node = root_;
+    while (node != kNil) {
+      //  key < node->key
+      if (Less(key, nodes_[node].key)) {
+        node = nodes_[node].left;
+        //  node->key < key
+      } else if (Less(nodes_[node].key, key)) {
+        node = nodes_[node].right;
+      } else {
+        break;
+      }
+    }
+    return node;
+  }
+
+  //  Returns the equal node, or kNil and where a new node should hang
+  index_type FindSlot(const Key &key, index_type *parent, bool *left) const {
+    index_type node = root_;
+    while (node != kNil) {
+      *parent = node;
+      if (Less(key, nodes_[node].key)) {
+        *left = true;
+        node = nodes_[node].left;
+      } else if (Less(nodes_[node].key, key)) {
+        *left = false;
+        node = nodes_[node].right;
+      } else {
+        return node;
+      }
+    }
+    return kNil;
+  }
+
+  void Link(index_type index, index_type parent, bool left) {
+    nodes_[index].parent = parent;
+    if (parent == kNil) {
+      root_ = index;
+    } else if (left) {
+      nodes_[parent].left = index;
+    } else {
+      nodes_[parent].right = index;
+    }
+  }
+
+  //  Puts `to` where `from` hangs, `from` keeps its own children
+  void Transplant(index_type from, index_type to) {
+    index_type parent = nodes_[from].parent;
+    if (parent == kNil) {
+      root_ = to;
+    } else if (nodes_[parent].left == from) {
+      nodes_[parent].left = to;
+    } else {
+      nodes_[parent].right = to;
+    }
+    if (to != kNil) nodes_[to].parent = parent;
+  }
+
+  void Unlink(index_type index) {
+    Node &node = nodes_[index];
+    if (node.left == kNil) {
+      Transplant(index, node.right);
+    } else if (node.right == kNil) {
+      Transplant(index, node.left);
+    } else {
+      index_type successor = Leftmost(node.right);
+      if (nodes_[successor].parent != index) {
+        Transplant(successor, nodes_[successor].right);
+        nodes_[successor].right = node.right;
+        nodes_[node.right].parent = successor;
+      }
+      Transplant(index, successor);
+      nodes_[successor].left = node.left;
+      nodes_[node.left].parent = successor;
+    }
+  }
+
+  //  The key is forwarded into the new node only once a free slot is found
+  template <class K>
+  std::pair<iterator, bool> InsertIt(K &&value) {
+    index_type parent = kNil;
+    bool left = false;
+    index_type found = FindSlot(value, &parent, &left);
+    if (found != kNil) {
+      return std::make_pair(iterator(this, found), false);
+    }
+    index_type index = NewNode(std::forward<K>(value));
+    Link(index, parent, left);
+    return std::make_pair(iterator(this, index), true);
+  }
+
+  template <class... Args>
+  index_type NewNode(Args &&...args) {
+    index_type index = free_;
+    if (index == kNil) {
+      if (used_ == capacity_) {
+        if (capacity_ >= max_size()) {
+          throw std::length_error("CompactTree: index space exhausted");
+        }
+        size_type wanted = capacity_ ? size_type{capacity_} * 2 : 16;
+        Grow(static_cast<index_type>(wanted < max_size() ? wanted
+                                                         : max_size()));
+      }
+      index = used_;
+      allocator_traits::construct(allocator_, nodes_ + index,
+                                  std::forward<Args>(args)...);
+      ++used_;
+    } else {
+      index_type next = *std::launder(reinterpret_cast<index_type *>(
+          static_cast<void *>(nodes_ + index)));
+      try {
+        allocator_traits::construct(allocator_, nodes_ + index,
+                                    std::forward<Args>(args)...);
+      } catch (...) {
+        //  A half-built key may have scribbled over the link
+        ::new (static_cast<void *>(nodes_ + index)) index_type(next);
+        throw;
+      }
+      free_ = next;
+    }
+    ++size_;
+    return index;
+  }
+
+  void DealocNode(index_type index) {
+    allocator_traits::destroy(allocator_, nodes_ + index);
+    ::new (static_cast<void *>(nodes_ + index)) index_type(free_);
+    free_ = index;
+    --size_;
+  }
+
+  //  Only called with every slot below used_ alive
+  void Grow(index_type capacity) {
+    Node *fresh = allocator_traits::allocate(allocator_, capacity);
+    index_type i = 0;
+    try {
+      for (; i < used_; ++i) {
+        allocator_traits::construct(allocator_, fresh + i,
+                                    std::move_if_noexcept(nodes_[i].key));
+        fresh[i].left = nodes_[i].left;
+        fresh[i].right = nodes_[i].right;
+        fresh[i].parent = nodes_[i].parent;
+      }
+    } catch (...) {
+      for (index_type j = 0; j < i; ++j) {
+        allocator_traits::destroy(allocator_, fresh + j);
+      }
+      allocator_traits::deallocate(allocator_, fresh, capacity);
+      throw;
+    }
+    for (index_type j = 0; j < used_; ++j) {
+      allocator_traits::destroy(allocator_, nodes_ + j);
+    }
+    allocator_traits::deallocate(allocator_, nodes_, capacity_);
+    nodes_ = fresh;
+    capacity_ = capacity;
+  }
+
+  //  Moves the live keys to the front of a new arena in key order and
+  //  relinks them as a balanced tree, dropping the free list
+  void Compact(index_type capacity) {
+    Node *fresh = allocator_traits::allocate(allocator_, capacity);
+    index_type i = 0;
+    try {
+      for (index_type n = Leftmost(root_); n != kNil; n = Next(n), ++i) {
+        allocator_traits::construct(allocator_, fresh + i,
+                                    std::move_if_noexcept(nodes_[n].key));
+      }
+    } catch (...) {
+      for (index_type j = 0; j < i; ++j) {
+        allocator_traits::destroy(allocator_, fresh + j);
+      }
+      allocator_traits::deallocate(allocator_, fresh, capacity);
+      throw;
+    }
+    DestroyTree(root_);
+    allocator_traits::deallocate(allocator_, nodes_, capacity_);
+    nodes_ = fresh;
+    capacity_ = capacity;
+    used_ = i;
+    free_ = kNil;
+    root_ = BuildBalanced(0, used_, kNil);
+  }
+
+  //  Iterative so degenerate trees cannot exhaust the stack
+  void DestroyTree(index_type index) {
+    while (index != kNil) {
+      Node &node = nodes_[index];
+      index_type next = node.left != kNil ? node.left : node.right;
+      if (next != kNil) {
+        (node.left != kNil ? node.left : node.right) = kNil;
+      } else {
+        next = node.parent;
+        allocator_traits::destroy(allocator_, nodes_ + index);
+      }
+      index = next;
+    }
+  }
+
+  //  Copies in key order, so the copy comes out balanced
+  void CopyTree(const CompactTree &other) {
+    if (other.root_ == kNil) {
+      return;
+    }
+    reserve(other.size_);
+    try {
+      for (auto it = other.begin(); it != other.end(); ++it) {
+        NewNode(*it);
+      }
+    } catch (...) {
+      for (index_type i = 0; i < used_; ++i) {
+        allocator_traits::destroy(allocator_, nodes_ + i);
+      }
+      allocator_traits::deallocate(allocator_, nodes_, capacity_);
+      nodes_ = nullptr;
+      capacity_ = used_ = 0;
+      size_ = 0;
+      throw;
+    }
+    root_ = BuildBalanced(0, used_, kNil);
+  }
+
+  index_type BuildBalanced(index_type first, index_type last,
+                           index_type parent) {
+    if (first == last) return kNil;
+    index_type middle = first + (last - first) / 2;
+    nodes_[middle].parent = parent;
+    nodes_[middle].left = BuildBalanced(first, middle, middle);
+    nodes_[middle].right = BuildBalanced(middle + 1, last, middle);
+    return middle;
+  }
+};  // class CompactTree
+
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
+class compact_set : public CompactTree<Key, Compare, Allocator> {
+ public:
+  using CTree = CompactTree<Key, Compare, Allocator>;
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename CTree::iterator;
+  using const_iterator = typename CTree::const_iterator;
+  using size_type = typename CTree::size_type;
+
+  compact_set() {}
+  compact_set(std::initializer_list<value_type> const &items) : CTree(items) {}
+};  // class compact_set
+
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class compact_map
+    : public CompactTree<std::pair<const Key, T>,
+                         MyComparator<Key, T, Compare>, Allocator> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using CTree =
+      CompactTree<value_type, MyComparator<Key, T, Compare>, Allocator>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename CTree::iterator;
+  using const_iterator = typename CTree::const_iterator;
+  using size_type = typename CTree::size_type;
+  using index_type = typename CTree::index_type;
+
+  compact_map() {}
+  compact_map(std::initializer_list<value_type> const &items) : CTree(items) {}
+
+  mapped_type &at(const key_type &key) {
+    index_type search = SearchMap(key);
+    if (search == CTree::kNil) {
+      throw std::out_of_range("Fail");
+    }
+    return this->At(search).key.second;
+  }
+
+  mapped_type &operator[](const key_type &key) {
+    index_type search = SearchMap(key);
+    if (search == CTree::kNil) {
+      return EmplaceMap(key, mapped_type{}).first->second;
+    }
+    return this->At(search).key.second;
+  }
+
+  mapped_type &operator[](key_type &&key) {
+    index_type search = SearchMap(key);
+    if (search == CTree::kNil) {
+      return EmplaceMap(std::move(key), mapped_type{}).first->second;
+    }
+    return this->At(search).key.second;
+  }
+
+  bool contains(const key_type &key) const {
+    return SearchMap(key) != CTree::kNil;
+  }
+
+  template <class K, class V>
+  std::pair<iterator, bool> insert_or_assign(K &&key, V &&obj) {
+    index_type search = SearchMap(key);
+    if (search == CTree::kNil) {
+      return EmplaceMap(std::forward<K>(key), std::forward<V>(obj));
+    }
+    this->At(search).key.second = std::forward<V>(obj);
+    return std::make_pair(iterator(this, search), false);
+  }
+
+  using CTree::insert;
+  //  The pair is built once, directly inside the new node
+  template <class K, class V>
+  std::pair<iterator, bool> insert(K &&key, V &&obj) {
+    return EmplaceMap(std::forward<K>(key), std::forward<V>(obj));
+  }
+
+ private:
+  index_type SearchMap(const key_type &key) const {
+    index_type node = this->root_;
+    while (node != CTree::kNil) {
+      const key_type &node_key = this->At(node).key.first;
+      //  key < node->key
+      if (Compare{}(key, node_key)) {
+        node = this->At(node).left;
+        //  node->key < key
+      } else if (Compare{}(node_key, key)) {
+        node = this->At(node).right;
+      } else {
+        break;
+      }
+    }
+    return node;
+  }
+
+  //  Like InsertIt, but compares by key alone so the pair is only built
+  //  once the key is known to be new
+  template <class K, class V>
+  std::pair<iterator, bool> EmplaceMap(K &&key, V &&obj) {
+    const key_type &probe = key;
+    index_type parent = CTree::kNil;
+    bool left = false;
+    index_type node = this->root_;
+    while (node != CTree::kNil) {
+      parent = node;
+      const key_type &node_key = this->At(node).key.first;
+      if (Compare{}(probe, node_key)) {
+        left = true;
+        node = this->At(node).left;
+      } else if (Compare{}(node_key, probe)) {
+        left = false;
+        node = this->At(node).right;
+      } else {
+        return std::make_pair(iterator(this, node), false);
+      }
+    }
+    index_type index =
+        this->NewNode(std::forward<K>(key), std::forward<V>(obj));
+    this->Link(index, parent, left);
+    return std::make_pair(iterator(this, index), true);
+  }
+};  // class compact_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_COMPACT_TREE_H_
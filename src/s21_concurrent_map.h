@@ -0,0 +1,148 @@
+#ifndef CONTAINERS_SRC_S21_CONCURRENT_MAP_H_
+#define CONTAINERS_SRC_S21_CONCURRENT_MAP_H_
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <system_error>
+
+#include "s21_hash.h"
+#include "s21_map.h"
+
+namespace s21 {
+//  Keys are spread by hash over Shards independent s21::map instances,
+//  each behind its own reader/writer lock, so writers to different shards
+//  never contend. Each shard sits on its own cache lines.
+template <class Key, class T, std::size_t Shards = 16,
+          class Hash = hash<Key>, class Compare = std::less<Key>>
+class concurrent_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using map_type = s21::map<Key, T, Compare>;
+  using value_type = typename map_type::value_type;
+  using size_type = std::size_t;
+  static_assert(Shards > 0, "concurrent_map needs at least one shard");
+
+  concurrent_map() {}
+  concurrent_map(std::initializer_list<value_type> const &items) {
+    for (auto it = items.begin(); it != items.end(); ++it) {
+      upsert(it->first, it->second);
+    }
+  }
+  concurrent_map(const concurrent_map &) = delete;
+  concurrent_map &operator=(const concurrent_map &) = delete;
+
+  //  Calls fn(const T &) under the shard's shared lock, false if missing
+  template <class Fn>
+  bool visit(const Key &key, Fn &&fn) const {
+    Shard &shard = ShardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.lock);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return false;
+    std::forward<Fn>(fn)(static_cast<const T &>(it->second));
+    return true;
+  }
+
+  bool contains(const Key &key) const {
+    Shard &shard = ShardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.lock);
+    return shard.map.contains(key);
+  }
+
+  //  Inserts or overwrites, true if the key was new
+  template <class K, class V>
+  bool upsert(K &&key, V &&obj) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    return shard.map.insert_or_assign(std::forward<K>(key), std::forward<V>(obj))
+        .second;
+  }
+
+  //  Calls fn(T &) on the existing value, or inserts make() if missing
+  template <class Make, class Fn>
+  bool upsert_with(const Key &key, Make &&make, Fn &&fn) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) {
+      shard.map.insert(key, std::forward<Make>(make)());
+      return true;
+    }
+    std::forward<Fn>(fn)(it->second);
+    return false;
+  }
+
+  bool erase(const Key &key) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    return shard.map.erase(key) != 0;
+  }
+
+  //  Not a snapshot, shards are counted one after another
+  size_type size() const {
+    size_type total = 0;
+    for (Shard &shard : shards_) {
+      std::shared_lock<std::shared_mutex> lock(shard.lock);
+      total += shard.map.size();
+    }
+    return total;
+  }
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    for (Shard &shard : shards_) {
+      std::unique_lock<std::shared_mutex> lock(shard.lock);
+      shard.map.clear();
+    }
+  }
+
+  //  Calls fn(const value_type &) for every entry, one task per shard under
+  //  that shard's shared lock; fn must be safe to run concurrently
+  template <class Fn>
+  void for_each(Fn fn) const {
+    std::future<void> jobs[Shards];
+    for (size_type i = 0; i < Shards; ++i) {
+      try {
+        jobs[i] = std::async(std::launch::async, [this, i, &fn] {
+          VisitShard(shards_[i], fn);
+        });
+      } catch (const std::system_error &) {
+        //  Out of threads, walk this shard here
+        VisitShard(shards_[i], fn);
+      }
+    }
+    for (size_type i = 0; i < Shards; ++i) {
+      if (jobs[i].valid()) jobs[i].get();
+    }
+  }
+
+ private:
+  struct alignas(64) Shard {
+    std::shared_mutex lock;
+    map_type map;
+  };
+  //  Mutable only so const methods can take a shard's shared_mutex
+  mutable Shard shards_[Shards];
+
+  //  Identity hashes are spread before reducing; skipped for avalanching
+  //  hashers
+  Shard &ShardFor(const Key &key) const {
+    std::uint64_t hash = Hash{}(key);
+    if constexpr (!IsAvalanching<Hash>::value) hash *= 0x9E3779B97F4A7C15ull;
+    return shards_[(hash >> 32) % Shards];
+  }
+
+  template <class Fn>
+  static void VisitShard(Shard &shard, Fn &fn) {
+    std::shared_lock<std::shared_mutex> lock(shard.lock);
+    for (auto it = shard.map.begin(); it != shard.map.end(); ++it) {
+      fn(static_cast<const value_type &>(*it));
+    }
+  }
+};  // class concurrent_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_CONCURRENT_MAP_H_
@@ -0,0 +1,407 @@
+#ifndef CONTAINERS_SRC_S21_CONCURRENT_UNORDERED_MAP_H_
+#define CONTAINERS_SRC_S21_CONCURRENT_UNORDERED_MAP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "s21_epoch.h"
+#include "s21_hash.h"
+
+namespace s21 {
+//  Hash map for many threads at once. Readers never lock: they pin an
+//  epoch with an EpochGuard and walk a bucket chain of immutable nodes.
+//  Writers lock one of Stripes mutexes, chosen by the low hash bits, and
+//  publish changes with a single pointer store: a new node at the chain
+//  head, or a replacement node spliced in over the old one. Unlinked
+//  nodes are freed once no reader can still hold them.
+//
+//  Growing copies every node into a table twice the size while holding
+//  all stripes, then publishes it with one store. Writers wait for the
+//  copy, readers keep walking the old table until they next look. An old
+//  table a reader still held is freed by a later write or erase.
+//  Key and T must be copy constructible.
+template <class Key, class T, class Hash = hash<Key>,
+          class KeyEqual = std::equal_to<Key>, std::size_t Stripes = 64>
+class concurrent_unordered_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = std::size_t;
+  static_assert(Stripes > 0 && (Stripes & (Stripes - 1)) == 0,
+                "concurrent_unordered_map stripes must be a power of two");
+
+  explicit concurrent_unordered_map(size_type buckets = 0)
+      : table_(new Table(BucketsFor(buckets))) {}
+  concurrent_unordered_map(std::initializer_list<value_type> const &items)
+      : concurrent_unordered_map(items.size()) {
+    for (auto it = items.begin(); it != items.end(); ++it) {
+      upsert(it->first, it->second);
+    }
+  }
+  concurrent_unordered_map(const concurrent_unordered_map &) = delete;
+  concurrent_unordered_map &operator=(const concurrent_unordered_map &) =
+      delete;
+  ~concurrent_unordered_map() {
+    FreeTable(table_.load(std::memory_order_relaxed));
+    FreeTables(retired_tables_, ~epoch_type{});
+    for (Stripe &stripe : stripes_) FreeNodes(stripe.retired, ~epoch_type{});
+  }
+
+  //  Calls fn(const T &) on the value, false if missing. Lock free; fn
+  //  sees the value as it was when the lookup found it.
+  template <class Fn>
+  bool visit(const Key &key, Fn &&fn) const {
+    EpochGuard guard;
+    const Node *node = Find(key, Mix(hash_(key)));
+    if (node == nullptr) return false;
+    std::forward<Fn>(fn)(node->value.second);
+    return true;
+  }
+
+  //  Copies the value into out, false if missing
+  bool find(const Key &key, T &out) const {
+    return visit(key, [&out](const T &value) { out = value; });
+  }
+
+  bool contains(const Key &key) const {
+    EpochGuard guard;
+    return Find(key, Mix(hash_(key))) != nullptr;
+  }
+
+  //  Inserts only if the key is missing, true if it did
+  template <class V>
+  bool insert(const Key &key, V &&obj) {
+    return Write(key, false, [&](Node *) {
+      return new Node(key, T(std::forward<V>(obj)));
+    });
+  }
+
+  //  Inserts or overwrites, true if the key was new
+  template <class V>
+  bool upsert(const Key &key, V &&obj) {
+    return Write(key, true, [&](Node *) {
+      return new Node(key, T(std::forward<V>(obj)));
+    });
+  }
+
+  //  Inserts make() if missing, otherwise calls fn(T &) on a copy of the
+  //  value that then replaces it, so readers never see a half update
+  template <class Make, class Fn>
+  bool upsert_with(const Key &key, Make &&make, Fn &&fn) {
+    return Write(key, true, [&](Node *old) {
+      if (old == nullptr) return new Node(key, std::forward<Make>(make)());
+      Node *node = new Node(key, old->value.second);
+      try {
+        fn(node->value.second);
+      } catch (...) {
+        delete node;
+        throw;
+      }
+      return node;
+    });
+  }
+
+  bool erase(const Key &key) {
+    std::uint64_t hash = Mix(hash_(key));
+    Stripe &stripe = stripes_[hash & (Stripes - 1)];
+    bool reclaim = false;
+    {
+      std::lock_guard<std::mutex> lock(stripe.lock);
+      Table *table = table_.load(std::memory_order_relaxed);
+      std::atomic<Node *> *link = &table->buckets[hash & table->mask];
+      Node *node = link->load(std::memory_order_relaxed);
+      for (; node != nullptr; node = link->load(std::memory_order_relaxed)) {
+        if (node->hash == hash && equal_(node->value.first, key)) break;
+        link = &node->next;
+      }
+      if (node == nullptr) return false;
+      link->store(node->next.load(std::memory_order_relaxed),
+                  std::memory_order_release);
+      --stripe.count;
+      reclaim = Retire(stripe, node);
+    }
+    if (reclaim) ReclaimTables();
+    return true;
+  }
+
+  //  Not a snapshot, stripes are counted one after another
+  size_type size() const {
+    size_type total = 0;
+    for (Stripe &stripe : stripes_) {
+      std::lock_guard<std::mutex> lock(stripe.lock);
+      total += stripe.count;
+    }
+    return total;
+  }
+  bool empty() const { return size() == 0; }
+
+  size_type bucket_count() const {
+    return table_.load(std::memory_order_acquire)->mask + 1;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> resize(resize_lock_);
+    //  Only resizes swap tables, so the size is settled before the stripes
+    //  are locked and a failed allocation leaves the map as it was
+    Table *old = table_.load(std::memory_order_relaxed);
+    Table *next = new Table(old->mask + 1);
+    std::unique_lock<std::mutex> locks[Stripes];
+    for (size_type i = 0; i < Stripes; ++i) {
+      locks[i] = std::unique_lock<std::mutex>(stripes_[i].lock);
+      stripes_[i].count = 0;
+    }
+    Publish(old, next);
+  }
+
+  //  Calls fn(const value_type &) for every entry without locking. Entries
+  //  inserted or erased during the walk may or may not be seen.
+  template <class Fn>
+  void for_each(Fn fn) const {
+    EpochGuard guard;
+    const Table *table = table_.load(std::memory_order_acquire);
+    for (size_type i = 0; i <= table->mask; ++i) {
+      for (const Node *node =
+               table->buckets[i].load(std::memory_order_acquire);
+           node != nullptr; node = node->next.load(std::memory_order_acquire)) {
+        fn(node->value);
+      }
+    }
+  }
+
+ private:
+  using epoch_type = EpochDomain::epoch_type;
+  //  Unlinked nodes a stripe keeps before trying to free them
+  static constexpr size_type kRetireBatch = 64;
+
+  struct Node {
+    template <class V>
+    Node(const Key &key, V &&obj)
+        : value(key, std::forward<V>(obj)) {}
+    std::uint64_t hash{};
+    value_type value;
+    std::atomic<Node *> next{};
+    Node *retired_next{};
+    //  0 until stamped by Retire
+    epoch_type retired_at{};
+  };
+
+  struct Table {
+    explicit Table(size_type buckets)
+        : mask(buckets - 1), buckets(new std::atomic<Node *>[buckets]()) {}
+    size_type mask;
+    std::unique_ptr<std::atomic<Node *>[]> buckets;
+    Table *retired_next{};
+    epoch_type retired_at{};
+  };
+
+  //  Buckets are at least Stripes, so a key's stripe is the same in every
+  //  table and a stripe lock covers its buckets across a resize
+  struct alignas(64) Stripe {
+    std::mutex lock;
+    size_type count{};
+    Node *retired{};
+    size_type retired_count{};
+  };
+
+  std::atomic<Table *> table_;
+  mutable Stripe stripes_[Stripes];
+  //  Taken by resize and clear, guards retired_tables_
+  std::mutex resize_lock_;
+  Table *retired_tables_{};
+  //  Whether retired_tables_ is non-empty, read without the lock
+  std::atomic<bool> tables_retired_{};
+  Hash hash_{};
+  KeyEqual equal_{};
+
+  //  std::hash is often the identity, so spread the bits first
+  static std::uint64_t Mix(std::uint64_t hash) {
+    if constexpr (IsAvalanching<Hash>::value) return hash;
+    hash *= 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 32);
+  }
+
+  static size_type BucketsFor(size_type count) {
+    size_type buckets = Stripes;
+    while (buckets < count) buckets *= 2;
+    return buckets;
+  }
+
+  //  Caller holds an EpochGuard
+  const Node *Find(const Key &key, std::uint64_t hash) const {
+    const Table *table = table_.load(std::memory_order_acquire);
+    for (const Node *node =
+             table->buckets[hash & table->mask].load(std::memory_order_acquire);
+         node != nullptr; node = node->next.load(std::memory_order_acquire)) {
+      if (node->hash == hash && equal_(node->value.first, key)) return node;
+    }
+    return nullptr;
+  }
+
+  //  make(old) builds the node for the key, old being the current node or
+  //  nullptr; with `replace` an existing node is swapped for the new one
+  //  in its chain. Returns true if the key was new.
+  template <class Make>
+  bool Write(const Key &key, bool replace, Make make) {
+    std::uint64_t hash = Mix(hash_(key));
+    Stripe &stripe = stripes_[hash & (Stripes - 1)];
+    Table *grow = nullptr;
+    bool inserted;
+    bool reclaim;
+    {
+      std::lock_guard<std::mutex> lock(stripe.lock);
+      Table *table = table_.load(std::memory_order_relaxed);
+      std::atomic<Node *> *head = &table->buckets[hash & table->mask];
+      std::atomic<Node *> *link = head;
+      Node *old = link->load(std::memory_order_relaxed);
+      for (; old != nullptr; old = link->load(std::memory_order_relaxed)) {
+        if (old->hash == hash && equal_(old->value.first, key)) break;
+        link = &old->next;
+      }
+      if (old != nullptr && !replace) return false;
+      Node *node = make(old);
+      node->hash = hash;
+      inserted = old == nullptr;
+      if (inserted) {
+        node->next.store(head->load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+        head->store(node, std::memory_order_release);
+        //  Grow once this stripe's share of the table averages one node
+        //  per bucket
+        if (++stripe.count * Stripes > table->mask + 1) grow = table;
+        reclaim = stripe.count % kRetireBatch == 0;
+      } else {
+        node->next.store(old->next.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+        link->store(node, std::memory_order_release);
+        reclaim = Retire(stripe, old);
+      }
+    }
+    if (grow != nullptr) {
+      Grow(grow);
+    } else if (reclaim) {
+      ReclaimTables();
+    }
+    return inserted;
+  }
+
+  //  Stamps pending nodes with a fresh epoch and frees what no reader can
+  //  still see. Caller holds the stripe lock. Returns true once a batch
+  //  was stamped, a good moment to check the retired tables as well.
+  bool Retire(Stripe &stripe, Node *node) {
+    node->retired_next = stripe.retired;
+    stripe.retired = node;
+    if (++stripe.retired_count < kRetireBatch) return false;
+    epoch_type now = epoch_domain().retire_epoch();
+    for (Node *pending = stripe.retired;
+         pending != nullptr && pending->retired_at == 0;
+         pending = pending->retired_next) {
+      pending->retired_at = now;
+    }
+    stripe.retired_count -= FreeNodes(stripe.retired, epoch_domain().oldest());
+    return true;
+  }
+
+  //  Frees the retired tables no reader still sees. Called without stripe
+  //  locks; skipped while a resize or clear holds the lock, as it frees
+  //  them itself.
+  void ReclaimTables() {
+    if (!tables_retired_.load(std::memory_order_relaxed)) return;
+    std::unique_lock<std::mutex> resize(resize_lock_, std::try_to_lock);
+    if (!resize.owns_lock()) return;
+    FreeTables(retired_tables_, epoch_domain().oldest());
+    tables_retired_.store(retired_tables_ != nullptr,
+                          std::memory_order_relaxed);
+  }
+
+  //  Frees listed nodes retired before `oldest`, returns how many
+  static size_type FreeNodes(Node *&list, epoch_type oldest) {
+    size_type freed = 0;
+    for (Node **link = &list; *link != nullptr;) {
+      Node *node = *link;
+      if (node->retired_at < oldest) {
+        *link = node->retired_next;
+        delete node;
+        ++freed;
+      } else {
+        link = &node->retired_next;
+      }
+    }
+    return freed;
+  }
+
+  static void FreeTable(Table *table) {
+    for (size_type i = 0; i <= table->mask; ++i) {
+      Node *node = table->buckets[i].load(std::memory_order_relaxed);
+      while (node != nullptr) {
+        Node *next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+      }
+    }
+    delete table;
+  }
+
+  static void FreeTables(Table *&list, epoch_type oldest) {
+    for (Table **link = &list; *link != nullptr;) {
+      Table *table = *link;
+      if (table->retired_at < oldest) {
+        *link = table->retired_next;
+        FreeTable(table);
+      } else {
+        link = &table->retired_next;
+      }
+    }
+  }
+
+  //  Swaps in next and retires old with all its nodes. Caller holds
+  //  resize_lock_ and every stripe.
+  void Publish(Table *old, Table *next) {
+    table_.store(next, std::memory_order_release);
+    old->retired_at = epoch_domain().retire_epoch();
+    old->retired_next = retired_tables_;
+    retired_tables_ = old;
+    FreeTables(retired_tables_, epoch_domain().oldest());
+    tables_retired_.store(retired_tables_ != nullptr,
+                          std::memory_order_relaxed);
+  }
+
+  //  Doubles the table unless another thread already replaced `seen`
+  void Grow(Table *seen) {
+    std::lock_guard<std::mutex> resize(resize_lock_);
+    if (table_.load(std::memory_order_relaxed) != seen) return;
+    std::unique_lock<std::mutex> locks[Stripes];
+    for (size_type i = 0; i < Stripes; ++i) {
+      locks[i] = std::unique_lock<std::mutex>(stripes_[i].lock);
+    }
+    std::unique_ptr<Table> next;
+    try {
+      next.reset(new Table(2 * (seen->mask + 1)));
+      for (size_type i = 0; i <= seen->mask; ++i) {
+        Node *node = seen->buckets[i].load(std::memory_order_relaxed);
+        for (; node != nullptr;
+             node = node->next.load(std::memory_order_relaxed)) {
+          Node *copy = new Node(node->value.first, node->value.second);
+          copy->hash = node->hash;
+          std::atomic<Node *> &head = next->buckets[copy->hash & next->mask];
+          copy->next.store(head.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+          head.store(copy, std::memory_order_relaxed);
+        }
+      }
+    } catch (...) {
+      //  Stay at the old size, the table is only more crowded
+      if (next != nullptr) FreeTable(next.release());
+      return;
+    }
+    Publish(seen, next.release());
+  }
+};  // class concurrent_unordered_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_CONCURRENT_UNORDERED_MAP_H_
@@ -2,6 +2,23 @@
 #define CONTAINERS_SRC_S21_CONTAINERS_PLUS_H_
 
 #include "s21_array.h"
+#include "s21_compact_tree.h"
+#include "s21_concurrent_map.h"
+#include "s21_concurrent_unordered_map.h"
+#include "s21_disk_btree_map.h"
+#include "s21_durable_map.h"
+#include "s21_hash.h"
+#include "s21_interval_map.h"
+#include "s21_multi_index.h"
+#include "s21_multimap.h"
 #include "s21_multiset.h"
+#include "s21_ordered_hash_map.h"
+#include "s21_perfect_hash_map.h"
+#include "s21_persistent_map.h"
+#include "s21_rcu_map.h"
+#include "s21_slab_map.h"
+#include "s21_static_map.h"
+#include "s21_unordered_map.h"
+#include "s21_unordered_set.h"
 
 #endif  //  CONTAINERS_SRC_S21_CONTAINERS_PLUS_H_
\ No newline at end of file
@@ -0,0 +1,707 @@
+#ifndef CONTAINERS_SRC_S21_DISK_BTREE_MAP_H_
+#define CONTAINERS_SRC_S21_DISK_BTREE_MAP_H_
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+//  Ordered map kept in a local file as a B+tree of PageSize pages, with
+//  only an LRU cache of pages in memory. Keys and values are stored by
+//  bytes, so both must be trivially copyable. Leaves are chained for
+//  sequential scans. Erase does not merge pages, so a page left empty
+//  stays in the chain and is skipped during scans.
+template <class K, class V, std::size_t PageSize = 4096,
+          class Compare = std::less<K>>
+class disk_btree_map {
+  static_assert(std::is_trivially_copyable<K>::value &&
+                    std::is_trivially_copyable<V>::value,
+                "disk_btree_map stores keys and values by bytes");
+  static_assert(PageSize >= 4096 && PageSize <= 16384 &&
+                    (PageSize & (PageSize - 1)) == 0,
+                "pages are 4, 8 or 16 KB");
+
+ public:
+  class DiskIterator;
+  using key_type = K;
+  using mapped_type = V;
+  //  Entries are copied out of their page, so the key is not const
+  using value_type = std::pair<K, V>;
+  using iterator = DiskIterator;
+  using const_iterator = DiskIterator;
+  using size_type = std::size_t;
+  using page_id = std::uint64_t;
+
+  //  Invalidated by any change to the map
+  class DiskIterator {
+    friend class disk_btree_map;
+
+   public:
+    using value_type = disk_btree_map::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    reference operator*() const { return current_; }
+    pointer operator->() const { return &current_; }
+    bool operator==(const DiskIterator &other) const {
+      return leaf_ == other.leaf_ && slot_ == other.slot_;
+    }
+    bool operator!=(const DiskIterator &other) const {
+      return !(*this == other);
+    }
+    DiskIterator &operator++() {
+      map_->Advance(&leaf_, &slot_, slot_ + 1);
+      Load();
+      return *this;
+    }
+    DiskIterator operator++(int) {
+      DiskIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+   private:
+    DiskIterator(disk_btree_map *map, page_id leaf, std::uint32_t slot)
+        : map_(map), leaf_(leaf), slot_(slot) {
+      Load();
+    }
+    void Load() {
+      if (leaf_ != 0) current_ = map_->Entry(leaf_, slot_);
+    }
+    disk_btree_map *map_;
+    //  Page 0 is the file header, so leaf 0 marks end()
+    page_id leaf_;
+    std::uint32_t slot_;
+    value_type current_{};
+  };  //  class DiskIterator
+
+  //  Opens or creates the file, keeping at most cache_pages pages in memory
+  explicit disk_btree_map(const std::string &path, size_type cache_pages = 256)
+      : cache_pages_(std::max(cache_pages, kMinCachePages)) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+    try {
+      InitCache();
+      Open();
+    } catch (...) {
+      ::close(fd_);
+      throw;
+    }
+  }
+  disk_btree_map(const disk_btree_map &) = delete;
+  disk_btree_map &operator=(const disk_btree_map &) = delete;
+  ~disk_btree_map() {
+    try {
+      flush();
+    } catch (...) {
+      //  Nothing left to report to; call flush() first to see errors
+    }
+    ::close(fd_);
+  }
+
+  iterator begin() {
+    page_id leaf = header_.first_leaf;
+    std::uint32_t slot = 0;
+    Advance(&leaf, &slot, 0);
+    return iterator(this, leaf, slot);
+  }
+  iterator end() { return iterator(this, 0, 0); }
+  bool empty() { return header_.size == 0; }
+  size_type size() { return header_.size; }
+  size_type height() { return header_.height; }
+
+  iterator find(const K &key) {
+    page_id leaf = FindLeaf(key);
+    PageRef page = Fetch(leaf);
+    std::uint32_t slot = LowerSlot(page.data(), key);
+    if (slot == Count(page.data()) || Less(key, LeafKeys(page.data())[slot])) {
+      return end();
+    }
+    return iterator(this, leaf, slot);
+  }
+
+  //  First entry whose key is not less than `key`, for range scans
+  iterator lower_bound(const K &key) {
+    page_id leaf = FindLeaf(key);
+    std::uint32_t slot = LowerSlot(Fetch(leaf).data(), key);
+    Advance(&leaf, &slot, slot);
+    return iterator(this, leaf, slot);
+  }
+
+  bool contains(const K &key) { return find(key) != end(); }
+
+  //  Returns a copy, the page may be evicted at any time
+  V at(const K &key) {
+    iterator it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("Fail");
+    }
+    return it->second;
+  }
+
+  std::pair<iterator, bool> insert(const K &key, const V &value) {
+    return Insert(key, value, false);
+  }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return Insert(value.first, value.second, false);
+  }
+  std::pair<iterator, bool> insert_or_assign(const K &key, const V &value) {
+    return Insert(key, value, true);
+  }
+
+  size_type erase(const K &key) {
+    PageRef page = Fetch(FindLeaf(key));
+    unsigned char *data = page.data();
+    std::uint32_t count = Count(data);
+    std::uint32_t slot = LowerSlot(data, key);
+    if (slot == count || Less(key, LeafKeys(data)[slot])) {
+      return 0;
+    }
+    std::memmove(LeafKeys(data) + slot, LeafKeys(data) + slot + 1,
+                 (count - slot - 1) * sizeof(K));
+    std::memmove(LeafValues(data) + slot, LeafValues(data) + slot + 1,
+                 (count - slot - 1) * sizeof(V));
+    SetCount(data, count - 1);
+    page.mark_dirty();
+    --header_.size;
+    return 1;
+  }
+
+  //  Builds the tree bottom-up from entries sorted by strictly increasing
+  //  key, filling every page. The map must be empty. On a throw the map is
+  //  still empty; only file space is lost.
+  template <class InputIt>
+  void bulk_load(InputIt first, InputIt last) {
+    if (header_.size != 0) {
+      throw std::logic_error("disk_btree_map::bulk_load needs an empty map");
+    }
+    BulkLevels levels;
+    size_type count = 0;
+    page_id first_leaf = 0;
+    PageRef leaf;
+    for (; first != last; ++first, ++count) {
+      const K &key = first->first;
+      if (leaf && !Less(levels.last_key, key)) {
+        throw std::invalid_argument(
+            "disk_btree_map::bulk_load needs sorted keys");
+      }
+      if (leaf && Count(leaf.data()) == kLeafCapacity) {
+        PageRef next = NewPage(kLeaf);
+        SetNext(leaf.data(), next.id());
+        leaf.mark_dirty();
+        leaf = std::move(next);
+        StartPage(&levels, 0, key, leaf.id());
+      } else if (!leaf) {
+        leaf = NewPage(kLeaf);
+        first_leaf = leaf.id();
+        StartPage(&levels, 0, key, leaf.id());
+      }
+      std::uint32_t slot = Count(leaf.data());
+      LeafKeys(leaf.data())[slot] = key;
+      LeafValues(leaf.data())[slot] = first->second;
+      SetCount(leaf.data(), slot + 1);
+      levels.last_key = key;
+    }
+    if (count == 0) return;
+    leaf.release();
+    size_type top = levels.height - 1;
+    header_.root = levels.current[top];
+    header_.height = levels.height;
+    header_.first_leaf = first_leaf;
+    header_.size = count;
+  }
+
+  //  Writes dirty pages and the header back to the file
+  void flush() {
+    for (size_type i = 0; i < cache_pages_; ++i) {
+      if (frames_[i].dirty) WriteFrame(&frames_[i]);
+    }
+    WritePage(0, &header_, sizeof(header_));
+  }
+
+  //  flush() followed by fsync
+  void sync() {
+    flush();
+    if (::fsync(fd_) != 0) {
+      throw std::system_error(errno, std::generic_category(), "fsync");
+    }
+  }
+
+ private:
+  static constexpr std::uint64_t kMagic = 0x3132735F65657274ull;
+  static constexpr size_type kMinCachePages = 8;
+  static constexpr size_type kMaxHeight = 32;
+  static constexpr std::uint32_t kLeaf = 1;
+  static constexpr std::uint32_t kInner = 2;
+  static constexpr page_id kNoPage = ~page_id{};
+
+  struct FileHeader {
+    std::uint64_t magic;
+    std::uint64_t page_size;
+    page_id root;
+    std::uint64_t height;
+    std::uint64_t size;
+    std::uint64_t page_count;
+    page_id first_leaf;
+  };
+
+  struct PageHeader {
+    std::uint32_t kind;
+    std::uint32_t count;
+    page_id next;
+  };
+
+  static constexpr size_type AlignUp(size_type offset, size_type align) {
+    return (offset + align - 1) / align * align;
+  }
+
+  //  Leaf: header, keys, values. Inner: header, keys, one more child.
+  static constexpr size_type kKeysOffset = AlignUp(sizeof(PageHeader),
+                                                   alignof(K));
+  static constexpr size_type kLeafCapacity =
+      (PageSize - kKeysOffset - alignof(V)) / (sizeof(K) + sizeof(V));
+  static constexpr size_type kValuesOffset =
+      AlignUp(kKeysOffset + kLeafCapacity * sizeof(K), alignof(V));
+  static constexpr size_type kInnerCapacity =
+      (PageSize - kKeysOffset - alignof(page_id) - sizeof(page_id)) /
+      (sizeof(K) + sizeof(page_id));
+  static constexpr size_type kChildrenOffset =
+      AlignUp(kKeysOffset + kInnerCapacity * sizeof(K), alignof(page_id));
+  static_assert(kLeafCapacity >= 2 && kInnerCapacity >= 3,
+                "entries too large for the page size");
+
+  struct Frame {
+    alignas(64) unsigned char data[PageSize];
+    page_id page = kNoPage;
+    size_type pins{};
+    bool dirty{};
+    //  LRU order, most recent first
+    Frame *prev{};
+    Frame *next{};
+    //  Hash bucket chain
+    Frame *chain{};
+  };
+
+  //  Keeps a cached page from being evicted while in use
+  class PageRef {
+   public:
+    PageRef() {}
+    explicit PageRef(Frame *frame) : frame_(frame) {}
+    PageRef(PageRef &&other) noexcept : frame_(other.frame_) {
+      other.frame_ = nullptr;
+    }
+    PageRef &operator=(PageRef &&other) noexcept {
+      if (this != &other) {
+        release();
+        frame_ = other.frame_;
+        other.frame_ = nullptr;
+      }
+      return *this;
+    }
+    ~PageRef() { release(); }
+    explicit operator bool() const { return frame_ != nullptr; }
+    unsigned char *data() const { return frame_->data; }
+    page_id id() const { return frame_->page; }
+    void mark_dirty() { frame_->dirty = true; }
+    void release() {
+      if (frame_ != nullptr) --frame_->pins;
+      frame_ = nullptr;
+    }
+
+   private:
+    Frame *frame_{};
+  };
+
+  //  Rightmost open page on each level during bulk_load
+  struct BulkLevels {
+    size_type height{};
+    size_type pages[kMaxHeight]{};
+    page_id current[kMaxHeight]{};
+    K low[kMaxHeight]{};
+    K last_key{};
+  };
+
+  int fd_{-1};
+  FileHeader header_{};
+  size_type cache_pages_;
+  std::unique_ptr<Frame[]> frames_;
+  std::unique_ptr<Frame *[]> buckets_;
+  size_type bucket_mask_{};
+  Frame *lru_head_{};
+  Frame *lru_tail_{};
+
+  static bool Less(const K &a, const K &b, Compare cmp = Compare{}) {
+    return cmp(a, b);
+  }
+
+  static PageHeader *Header(unsigned char *data) {
+    return reinterpret_cast<PageHeader *>(data);
+  }
+  static std::uint32_t Count(unsigned char *data) {
+    return Header(data)->count;
+  }
+  static void SetCount(unsigned char *data, std::uint32_t count) {
+    Header(data)->count = count;
+  }
+  static page_id NextLeaf(unsigned char *data) { return Header(data)->next; }
+  static void SetNext(unsigned char *data, page_id next) {
+    Header(data)->next = next;
+  }
+  static K *LeafKeys(unsigned char *data) {
+    return reinterpret_cast<K *>(data + kKeysOffset);
+  }
+  static V *LeafValues(unsigned char *data) {
+    return reinterpret_cast<V *>(data + kValuesOffset);
+  }
+  static K *InnerKeys(unsigned char *data) {
+    return reinterpret_cast<K *>(data + kKeysOffset);
+  }
+  static page_id *Children(unsigned char *data) {
+    return reinterpret_cast<page_id *>(data + kChildrenOffset);
+  }
+
+  static std::uint32_t LowerSlot(unsigned char *data, const K &key) {
+    K *keys = LeafKeys(data);
+    return std::lower_bound(keys, keys + Count(data), key,
+                            [](const K &a, const K &b) { return Less(a, b); }) -
+           keys;
+  }
+
+  //  Child to follow; keys equal to a separator live on its right
+  static std::uint32_t ChildSlot(unsigned char *data, const K &key) {
+    K *keys = InnerKeys(data);
+    return std::upper_bound(keys, keys + Count(data), key,
+                            [](const K &a, const K &b) { return Less(a, b); }) -
+           keys;
+  }
+
+  void InitCache() {
+    frames_.reset(new Frame[cache_pages_]);
+    size_type buckets = 1;
+    while (buckets < 2 * cache_pages_) buckets <<= 1;
+    buckets_.reset(new Frame *[buckets]());
+    bucket_mask_ = buckets - 1;
+    for (size_type i = 0; i < cache_pages_; ++i) {
+      frames_[i].prev = i ? &frames_[i - 1] : nullptr;
+      frames_[i].next = (i + 1 < cache_pages_) ? &frames_[i + 1] : nullptr;
+    }
+    lru_head_ = &frames_[0];
+    lru_tail_ = &frames_[cache_pages_ - 1];
+  }
+
+  void Open() {
+    off_t length = ::lseek(fd_, 0, SEEK_END);
+    if (length < 0) {
+      throw std::system_error(errno, std::generic_category(), "lseek");
+    }
+    if (length == 0) {
+      header_ = FileHeader{kMagic, PageSize, 1, 1, 0, 1, 1};
+      PageRef root = NewPage(kLeaf);
+      root.release();
+      flush();
+      return;
+    }
+    ReadPage(0, &header_, sizeof(header_));
+    if (header_.magic != kMagic || header_.page_size != PageSize) {
+      throw std::runtime_error(
+          "disk_btree_map: not a tree file of this page size");
+    }
+  }
+
+  void ReadPage(page_id page, void *buffer, size_type length) {
+    ssize_t done = ::pread(fd_, buffer, length, off_t(page * PageSize));
+    if (done != ssize_t(length)) {
+      throw std::system_error(done < 0 ? errno : EIO, std::generic_category(),
+                              "pread");
+    }
+  }
+
+  void WritePage(page_id page, const void *buffer, size_type length) {
+    ssize_t done = ::pwrite(fd_, buffer, length, off_t(page * PageSize));
+    if (done != ssize_t(length)) {
+      throw std::system_error(done < 0 ? errno : EIO, std::generic_category(),
+                              "pwrite");
+    }
+  }
+
+  void WriteFrame(Frame *frame) {
+    WritePage(frame->page, frame->data, PageSize);
+    frame->dirty = false;
+  }
+
+  Frame *&Bucket(page_id page) {
+    return buckets_[(page * 0x9E3779B97F4A7C15ull >> 20) & bucket_mask_];
+  }
+
+  void Touch(Frame *frame) {
+    if (frame == lru_head_) return;
+    frame->prev->next = frame->next;
+    if (frame->next != nullptr) {
+      frame->next->prev = frame->prev;
+    } else {
+      lru_tail_ = frame->prev;
+    }
+    frame->prev = nullptr;
+    frame->next = lru_head_;
+    lru_head_->prev = frame;
+    lru_head_ = frame;
+  }
+
+  //  Pins a page, reading it in unless `fresh`, in which case it is zeroed
+  PageRef Fetch(page_id page, bool fresh = false) {
+    for (Frame *frame = Bucket(page); frame != nullptr; frame = frame->chain) {
+      if (frame->page == page) {
+        Touch(frame);
+        ++frame->pins;
+        return PageRef(frame);
+      }
+    }
+    Frame *victim = lru_tail_;
+    while (victim != nullptr && victim->pins != 0) victim = victim->prev;
+    if (victim == nullptr) {
+      throw std::runtime_error("disk_btree_map: every cached page is in use");
+    }
+    if (victim->dirty) WriteFrame(victim);
+    if (victim->page != kNoPage) {
+      Frame **link = &Bucket(victim->page);
+      while (*link != victim) link = &(*link)->chain;
+      *link = victim->chain;
+      victim->page = kNoPage;
+    }
+    if (fresh) {
+      std::memset(victim->data, 0, PageSize);
+    } else {
+      ReadPage(page, victim->data, PageSize);
+    }
+    victim->page = page;
+    victim->dirty = fresh;
+    victim->chain = Bucket(page);
+    Bucket(page) = victim;
+    Touch(victim);
+    ++victim->pins;
+    return PageRef(victim);
+  }
+
+  PageRef NewPage(std::uint32_t kind) {
+    PageRef page = Fetch(header_.page_count, true);
+    ++header_.page_count;
+    Header(page.data())->kind = kind;
+    return page;
+  }
+
+  page_id FindLeaf(const K &key) {
+    page_id page = header_.root;
+    for (size_type level = 1; level < header_.height; ++level) {
+      PageRef inner = Fetch(page);
+      page = Children(inner.data())[ChildSlot(inner.data(), key)];
+    }
+    return page;
+  }
+
+  value_type Entry(page_id leaf, std::uint32_t slot) {
+    PageRef page = Fetch(leaf);
+    return value_type(LeafKeys(page.data())[slot],
+                      LeafValues(page.data())[slot]);
+  }
+
+  //  Moves (leaf, slot) to the first entry at or after `slot`, skipping
+  //  empty leaves; leaf becomes 0 past the last entry
+  void Advance(page_id *leaf, std::uint32_t *slot, std::uint32_t from) {
+    *slot = from;
+    while (*leaf != 0) {
+      PageRef page = Fetch(*leaf);
+      if (*slot < Count(page.data())) return;
+      *leaf = NextLeaf(page.data());
+      *slot = 0;
+    }
+  }
+
+  std::pair<iterator, bool> Insert(const K &key, const V &value,
+                                   bool assign) {
+    page_id path[kMaxHeight];
+    std::uint32_t slots[kMaxHeight];
+    page_id page = header_.root;
+    for (size_type level = 0; level + 1 < header_.height; ++level) {
+      PageRef inner = Fetch(page);
+      path[level] = page;
+      slots[level] = ChildSlot(inner.data(), key);
+      page = Children(inner.data())[slots[level]];
+    }
+    PageRef leaf = Fetch(page);
+    unsigned char *data = leaf.data();
+    std::uint32_t count = Count(data);
+    std::uint32_t slot = LowerSlot(data, key);
+    if (slot < count && !Less(key, LeafKeys(data)[slot])) {
+      if (assign) {
+        LeafValues(data)[slot] = value;
+        leaf.mark_dirty();
+      }
+      leaf.release();
+      return std::make_pair(iterator(this, page, slot), false);
+    }
+    ++header_.size;
+    if (count < kLeafCapacity) {
+      InsertInLeaf(data, slot, key, value);
+      leaf.mark_dirty();
+      leaf.release();
+      return std::make_pair(iterator(this, page, slot), true);
+    }
+    //  Split: the upper half moves to a new right sibling
+    PageRef right = NewPage(kLeaf);
+    std::uint32_t half = count / 2;
+    std::memcpy(LeafKeys(right.data()), LeafKeys(data) + half,
+                (count - half) * sizeof(K));
+    std::memcpy(LeafValues(right.data()), LeafValues(data) + half,
+                (count - half) * sizeof(V));
+    SetCount(right.data(), count - half);
+    SetCount(data, half);
+    SetNext(right.data(), NextLeaf(data));
+    SetNext(data, right.id());
+    leaf.mark_dirty();
+    page_id target = page;
+    if (slot >= half) {
+      slot -= half;
+      target = right.id();
+      InsertInLeaf(right.data(), slot, key, value);
+    } else {
+      InsertInLeaf(data, slot, key, value);
+    }
+    K separator = LeafKeys(right.data())[0];
+    page_id right_id = right.id();
+    leaf.release();
+    right.release();
+    InsertInParent(path, slots, header_.height - 1, separator, right_id);
+    return std::make_pair(iterator(this, target, slot), true);
+  }
+
+  static void InsertInLeaf(unsigned char *data, std::uint32_t slot,
+                           const K &key, const V &value) {
+    std::uint32_t count = Count(data);
+    std::memmove(LeafKeys(data) + slot + 1, LeafKeys(data) + slot,
+                 (count - slot) * sizeof(K));
+    std::memmove(LeafValues(data) + slot + 1, LeafValues(data) + slot,
+                 (count - slot) * sizeof(V));
+    LeafKeys(data)[slot] = key;
+    LeafValues(data)[slot] = value;
+    SetCount(data, count + 1);
+  }
+
+  //  Adds (separator, right) next to the child split on path[level - 1]
+  void InsertInParent(page_id *path, std::uint32_t *slots, size_type level,
+                      K separator, page_id right) {
+    while (level > 0) {
+      --level;
+      PageRef inner = Fetch(path[level]);
+      unsigned char *data = inner.data();
+      std::uint32_t count = Count(data);
+      std::uint32_t slot = slots[level];
+      inner.mark_dirty();
+      if (count < kInnerCapacity) {
+        InsertInInner(data, slot, separator, right);
+        return;
+      }
+      //  Full: the middle key moves up, the keys after it move right
+      K keys[kInnerCapacity + 1];
+      page_id children[kInnerCapacity + 2];
+      std::memcpy(keys, InnerKeys(data), slot * sizeof(K));
+      keys[slot] = separator;
+      std::memcpy(keys + slot + 1, InnerKeys(data) + slot,
+                  (count - slot) * sizeof(K));
+      std::memcpy(children, Children(data), (slot + 1) * sizeof(page_id));
+      children[slot + 1] = right;
+      std::memcpy(children + slot + 2, Children(data) + slot + 1,
+                  (count - slot) * sizeof(page_id));
+      std::uint32_t half = (count + 1) / 2;
+      PageRef sibling = NewPage(kInner);
+      std::memcpy(InnerKeys(data), keys, half * sizeof(K));
+      std::memcpy(Children(data), children, (half + 1) * sizeof(page_id));
+      SetCount(data, half);
+      std::uint32_t moved = count - half;
+      std::memcpy(InnerKeys(sibling.data()), keys + half + 1,
+                  moved * sizeof(K));
+      std::memcpy(Children(sibling.data()), children + half + 1,
+                  (moved + 1) * sizeof(page_id));
+      SetCount(sibling.data(), moved);
+      separator = keys[half];
+      right = sibling.id();
+    }
+    //  The root itself split
+    PageRef root = NewPage(kInner);
+    InnerKeys(root.data())[0] = separator;
+    Children(root.data())[0] = header_.root;
+    Children(root.data())[1] = right;
+    SetCount(root.data(), 1);
+    header_.root = root.id();
+    ++header_.height;
+  }
+
+  static void InsertInInner(unsigned char *data, std::uint32_t slot,
+                            const K &separator, page_id right) {
+    std::uint32_t count = Count(data);
+    std::memmove(InnerKeys(data) + slot + 1, InnerKeys(data) + slot,
+                 (count - slot) * sizeof(K));
+    std::memmove(Children(data) + slot + 2, Children(data) + slot + 1,
+                 (count - slot) * sizeof(page_id));
+    InnerKeys(data)[slot] = separator;
+    Children(data)[slot + 1] = right;
+    SetCount(data, count + 1);
+  }
+
+  //  Records a new page at `level`; the first page of a level is handed
+  //  to the level above only once a second one shows up
+  void StartPage(BulkLevels *levels, size_type level, const K &low,
+                 page_id page) {
+    if (levels->pages[level] == 1) {
+      AppendChild(levels, level + 1, levels->low[level],
+                  levels->current[level]);
+    }
+    if (levels->pages[level] >= 1) {
+      AppendChild(levels, level + 1, low, page);
+    }
+    levels->current[level] = page;
+    levels->low[level] = low;
+    ++levels->pages[level];
+    levels->height = std::max(levels->height, level + 1);
+  }
+
+  void AppendChild(BulkLevels *levels, size_type level, const K &low,
+                   page_id child) {
+    if (level >= kMaxHeight) {
+      throw std::length_error("disk_btree_map: tree too deep");
+    }
+    if (levels->pages[level] != 0) {
+      PageRef inner = Fetch(levels->current[level]);
+      std::uint32_t count = Count(inner.data());
+      if (count < kInnerCapacity) {
+        InnerKeys(inner.data())[count] = low;
+        Children(inner.data())[count + 1] = child;
+        SetCount(inner.data(), count + 1);
+        inner.mark_dirty();
+        return;
+      }
+    }
+    PageRef inner = NewPage(kInner);
+    Children(inner.data())[0] = child;
+    page_id id = inner.id();
+    inner.release();
+    StartPage(levels, level, low, id);
+  }
+};  // class disk_btree_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_DISK_BTREE_MAP_H_
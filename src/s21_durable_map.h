@@ -0,0 +1,535 @@
+#ifndef CONTAINERS_SRC_S21_DURABLE_MAP_H_
+#define CONTAINERS_SRC_S21_DURABLE_MAP_H_
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "s21_map.h"
+
+namespace s21 {
+//  How a durable_map turns log records into bytes. Trivially copyable
+//  types are copied as is; specialize for anything else.
+template <class T, class Enable = void>
+struct durable_codec {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "specialize s21::durable_codec for this type");
+  static void encode(const T &value, std::string &out) {
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  //  Advances `in`, false if the bytes run out
+  static bool decode(const char *&in, const char *end, T &value) {
+    if (std::size_t(end - in) < sizeof(T)) return false;
+    std::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return true;
+  }
+};
+
+template <>
+struct durable_codec<std::string> {
+  static void encode(const std::string &value, std::string &out) {
+    durable_codec<std::uint64_t>::encode(std::uint64_t(value.size()), out);
+    out.append(value);
+  }
+  static bool decode(const char *&in, const char *end, std::string &value) {
+    std::uint64_t length{};
+    if (!durable_codec<std::uint64_t>::decode(in, end, length) ||
+        std::uint64_t(end - in) < length) {
+      return false;
+    }
+    value.assign(in, length);
+    in += length;
+    return true;
+  }
+};
+
+enum class durable_sync {
+  //  A mutation returns once its record is fsynced. Writers arriving
+  //  during an fsync share the next one.
+  every_write,
+  //  Records are written and fsynced together once batch_records of them
+  //  are pending or batch_interval has passed, checked on each mutation
+  batched,
+  //  Only commit(), compact() and the destructor fsync
+  none
+};
+
+struct durable_options {
+  durable_sync sync = durable_sync::every_write;
+  std::size_t batch_records = 64;
+  std::chrono::milliseconds batch_interval{10};
+  //  Snapshot and empty the log once it holds this many records, 0 never
+  std::size_t snapshot_records = std::size_t{1} << 20;
+};
+
+//  s21::map that survives restarts. Every mutation is appended to
+//  `path.log` before its call returns (as the sync policy allows) and
+//  compact() writes the whole map to `path.snap`, after which the log
+//  starts over. Opening replays the snapshot and then the log records
+//  newer than it; a torn record at the log's end is cut off.
+//  All members are thread safe. Readers may see a change before its
+//  record is on disk.
+template <class Key, class T, class Compare = std::less<Key>,
+          class KeyCodec = durable_codec<Key>,
+          class ValueCodec = durable_codec<T>>
+class durable_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using map_type = s21::map<Key, T, Compare>;
+  using value_type = typename map_type::value_type;
+  using size_type = typename map_type::size_type;
+
+  explicit durable_map(const std::string &path, durable_options options = {})
+      : log_path_(path + ".log"),
+        snap_path_(path + ".snap"),
+        options_(options) {
+    log_fd_ = ::open(log_path_.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (log_fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), log_path_);
+    }
+    try {
+      std::uint64_t snapshot_seq = LoadSnapshot();
+      ReplayLog(snapshot_seq);
+      SyncDirectory();
+    } catch (...) {
+      ::close(log_fd_);
+      throw;
+    }
+    written_seq_ = synced_seq_ = last_seq_;
+    last_sync_ = std::chrono::steady_clock::now();
+  }
+  durable_map(const durable_map &) = delete;
+  durable_map &operator=(const durable_map &) = delete;
+  ~durable_map() {
+    try {
+      commit();
+    } catch (...) {
+      //  Call commit() first to see errors
+    }
+    ::close(log_fd_);
+  }
+
+  //  Calls fn(const map_type &) under the lock
+  template <class Fn>
+  decltype(auto) read(Fn &&fn) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::forward<Fn>(fn)(static_cast<const map_type &>(table_));
+  }
+
+  //  Copies the value out, false if the key is missing
+  bool find(const Key &key, T &out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = table_.find(key);
+    if (it == table_.end()) return false;
+    out = it->second;
+    return true;
+  }
+
+  bool contains(const Key &key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return table_.contains(key);
+  }
+
+  T at(const Key &key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return table_.at(key);
+  }
+
+  size_type size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return table_.size();
+  }
+  bool empty() const { return size() == 0; }
+
+  //  False, with nothing logged, if the key is present
+  bool insert(const Key &key, const T &value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (table_.contains(key)) return false;
+    Log(kPut, key, &value, [&] { table_.insert(key, value); });
+    Committed(lock);
+    return true;
+  }
+
+  //  True if the key was new
+  bool insert_or_assign(const Key &key, const T &value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool inserted = false;
+    Log(kPut, key, &value,
+        [&] { inserted = table_.insert_or_assign(key, value).second; });
+    Committed(lock);
+    return inserted;
+  }
+
+  size_type erase(const Key &key) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!table_.contains(key)) return 0;
+    Log(kErase, key, nullptr, [&] { table_.erase(key); });
+    Committed(lock);
+    return 1;
+  }
+
+  //  Waits until every mutation made so far is fsynced
+  void commit() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Flush(lock, last_seq_, true);
+  }
+
+  //  Writes a snapshot of the map and empties the log. Mutations wait
+  //  while the snapshot is written.
+  void compact() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Compact(lock);
+  }
+
+ private:
+  static constexpr std::uint64_t kSnapshotMagic = 0x70616E73316C3273ull;
+  static constexpr std::uint8_t kPut = 1;
+  static constexpr std::uint8_t kErase = 2;
+  //  Without fsyncs, pending records still go to the file past this size
+  static constexpr std::size_t kWriteChunk = std::size_t{1} << 16;
+
+  //  Standard reflected CRC-32 table
+  struct CrcTable {
+    std::uint32_t entry[256];
+    constexpr CrcTable() : entry() {
+      for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+          crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0);
+        }
+        entry[i] = crc;
+      }
+    }
+  };
+
+  std::string log_path_;
+  std::string snap_path_;
+  durable_options options_;
+  int log_fd_{-1};
+  mutable std::mutex mutex_;
+  mutable map_type table_;
+  //  Encoded records not yet handed to the file
+  std::string pending_;
+  std::uint64_t last_seq_{};
+  std::uint64_t written_seq_{};
+  std::uint64_t synced_seq_{};
+  std::size_t unsynced_{};
+  std::size_t log_records_{};
+  std::chrono::steady_clock::time_point last_sync_;
+  //  One thread at a time writes the log with the lock released
+  bool flushing_{};
+  //  Set after a failed write: later records could follow a torn one
+  bool broken_{};
+  std::condition_variable flushed_;
+
+  static std::uint32_t Crc32(const char *data, std::size_t length,
+                             std::uint32_t crc = 0) {
+    static constexpr CrcTable table;
+    crc = ~crc;
+    for (std::size_t i = 0; i < length; ++i) {
+      crc = table.entry[(crc ^ std::uint8_t(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+  }
+
+  static void WriteAll(int fd, const char *data, std::size_t length) {
+    while (length != 0) {
+      ssize_t done = ::write(fd, data, length);
+      if (done < 0) {
+        if (errno == EINTR) continue;
+        throw std::system_error(errno, std::generic_category(), "write");
+      }
+      data += done;
+      length -= done;
+    }
+  }
+
+  static void Fsync(int fd) {
+    if (::fdatasync(fd) != 0) {
+      throw std::system_error(errno, std::generic_category(), "fdatasync");
+    }
+  }
+
+  static std::string ReadFile(int fd) {
+    std::string data;
+    char buffer[1 << 16];
+    for (;;) {
+      ssize_t done = ::read(fd, buffer, sizeof(buffer));
+      if (done < 0) {
+        if (errno == EINTR) continue;
+        throw std::system_error(errno, std::generic_category(), "read");
+      }
+      if (done == 0) return data;
+      data.append(buffer, done);
+    }
+  }
+
+  //  Makes renames and new files in the map's directory durable
+  void SyncDirectory() {
+    std::string::size_type slash = snap_path_.rfind('/');
+    std::string dir =
+        (slash == std::string::npos) ? "." : snap_path_.substr(0, slash + 1);
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), dir);
+    }
+    int result = ::fsync(fd);
+    int error = errno;
+    ::close(fd);
+    if (result != 0) {
+      throw std::system_error(error, std::generic_category(), dir);
+    }
+  }
+
+  //  Appends the record, then runs apply; a throw from either leaves
+  //  neither the map nor the log changed
+  template <class Apply>
+  void Log(std::uint8_t op, const Key &key, const T *value, Apply apply) {
+    if (broken_) {
+      throw std::runtime_error("durable_map: an earlier log write failed");
+    }
+    std::string body;
+    durable_codec<std::uint64_t>::encode(last_seq_ + 1, body);
+    durable_codec<std::uint8_t>::encode(op, body);
+    KeyCodec::encode(key, body);
+    if (value != nullptr) ValueCodec::encode(*value, body);
+    std::size_t mark = pending_.size();
+    durable_codec<std::uint32_t>::encode(std::uint32_t(body.size()), pending_);
+    durable_codec<std::uint32_t>::encode(Crc32(body.data(), body.size()),
+                                         pending_);
+    pending_.append(body);
+    try {
+      apply();
+    } catch (...) {
+      pending_.resize(mark);
+      throw;
+    }
+    ++last_seq_;
+    ++unsynced_;
+    ++log_records_;
+  }
+
+  void Committed(std::unique_lock<std::mutex> &lock) {
+    if (options_.sync == durable_sync::every_write) {
+      Flush(lock, last_seq_, true);
+    } else if (options_.sync == durable_sync::batched) {
+      if (unsynced_ >= options_.batch_records ||
+          std::chrono::steady_clock::now() - last_sync_ >=
+              options_.batch_interval) {
+        Flush(lock, last_seq_, true);
+      }
+    } else if (pending_.size() >= kWriteChunk) {
+      Flush(lock, last_seq_, false);
+    }
+    if (options_.snapshot_records != 0 &&
+        log_records_ >= options_.snapshot_records) {
+      Compact(lock);
+    }
+  }
+
+  //  Group commit: whoever finds no write in progress takes every pending
+  //  record to the file with the lock released, the others wait for it
+  void Flush(std::unique_lock<std::mutex> &lock, std::uint64_t seq,
+             bool durable) {
+    while ((durable ? synced_seq_ : written_seq_) < seq) {
+      if (flushing_) {
+        flushed_.wait(lock);
+        continue;
+      }
+      if (broken_) {
+        throw std::runtime_error("durable_map: an earlier log write failed");
+      }
+      flushing_ = true;
+      std::string batch;
+      batch.swap(pending_);
+      std::uint64_t upto = last_seq_;
+      lock.unlock();
+      try {
+        WriteAll(log_fd_, batch.data(), batch.size());
+        if (durable) Fsync(log_fd_);
+      } catch (...) {
+        lock.lock();
+        flushing_ = false;
+        broken_ = true;
+        flushed_.notify_all();
+        throw;
+      }
+      lock.lock();
+      flushing_ = false;
+      written_seq_ = upto;
+      if (durable) {
+        synced_seq_ = upto;
+        unsynced_ = 0;
+        last_sync_ = std::chrono::steady_clock::now();
+      }
+      flushed_.notify_all();
+    }
+  }
+
+  //  The snapshot covers every record, so the log can start over; should
+  //  the truncate not happen, replay skips records the snapshot covers
+  void Compact(std::unique_lock<std::mutex> &lock) {
+    while (flushing_) flushed_.wait(lock);
+    WriteSnapshot();
+    pending_.clear();
+    if (::ftruncate(log_fd_, 0) != 0) {
+      throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+    Fsync(log_fd_);
+    written_seq_ = synced_seq_ = last_seq_;
+    unsynced_ = log_records_ = 0;
+    last_sync_ = std::chrono::steady_clock::now();
+  }
+
+  //  Layout: magic, sequence, count, entries, CRC-32 of all before it
+  void WriteSnapshot() {
+    std::string temp_path = snap_path_ + ".tmp";
+    int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), temp_path);
+    }
+    try {
+      std::string buffer;
+      std::uint32_t crc = 0;
+      durable_codec<std::uint64_t>::encode(kSnapshotMagic, buffer);
+      durable_codec<std::uint64_t>::encode(last_seq_, buffer);
+      durable_codec<std::uint64_t>::encode(std::uint64_t(table_.size()),
+                                            buffer);
+      for (auto it = table_.begin(); it != table_.end(); ++it) {
+        KeyCodec::encode(it->first, buffer);
+        ValueCodec::encode(it->second, buffer);
+        if (buffer.size() >= kWriteChunk) {
+          crc = Crc32(buffer.data(), buffer.size(), crc);
+          WriteAll(fd, buffer.data(), buffer.size());
+          buffer.clear();
+        }
+      }
+      crc = Crc32(buffer.data(), buffer.size(), crc);
+      durable_codec<std::uint32_t>::encode(crc, buffer);
+      WriteAll(fd, buffer.data(), buffer.size());
+      Fsync(fd);
+    } catch (...) {
+      ::close(fd);
+      ::unlink(temp_path.c_str());
+      throw;
+    }
+    ::close(fd);
+    if (::rename(temp_path.c_str(), snap_path_.c_str()) != 0) {
+      throw std::system_error(errno, std::generic_category(), snap_path_);
+    }
+    SyncDirectory();
+  }
+
+  //  Returns the sequence number the snapshot covers, 0 without one
+  std::uint64_t LoadSnapshot() {
+    int fd = ::open(snap_path_.c_str(), O_RDONLY);
+    if (fd < 0) {
+      if (errno == ENOENT) return 0;
+      throw std::system_error(errno, std::generic_category(), snap_path_);
+    }
+    std::string data;
+    try {
+      data = ReadFile(fd);
+    } catch (...) {
+      ::close(fd);
+      throw;
+    }
+    ::close(fd);
+    const char *in = data.data();
+    const char *end = in + data.size();
+    std::uint64_t magic{}, seq{}, count{};
+    std::uint32_t crc{};
+    if (data.size() < 3 * sizeof(magic) + sizeof(crc)) {
+      throw std::runtime_error("durable_map: damaged snapshot " + snap_path_);
+    }
+    end -= sizeof(crc);
+    std::memcpy(&crc, end, sizeof(crc));
+    if (crc != Crc32(data.data(), data.size() - sizeof(crc))) {
+      throw std::runtime_error("durable_map: damaged snapshot " + snap_path_);
+    }
+    durable_codec<std::uint64_t>::decode(in, end, magic);
+    durable_codec<std::uint64_t>::decode(in, end, seq);
+    durable_codec<std::uint64_t>::decode(in, end, count);
+    if (magic != kSnapshotMagic) {
+      throw std::runtime_error("durable_map: not a snapshot " + snap_path_);
+    }
+    for (std::uint64_t i = 0; i < count; ++i) {
+      Key key{};
+      T value{};
+      if (!KeyCodec::decode(in, end, key) ||
+          !ValueCodec::decode(in, end, value)) {
+        throw std::runtime_error("durable_map: damaged snapshot " + snap_path_);
+      }
+      //  Entries come sorted, so each lands at the end in O(1)
+      table_.insert(table_.end(), value_type(std::move(key), std::move(value)));
+    }
+    last_seq_ = seq;
+    return seq;
+  }
+
+  //  Applies records newer than the snapshot, cutting the log at the
+  //  first torn or damaged one
+  void ReplayLog(std::uint64_t snapshot_seq) {
+    std::string data = ReadFile(log_fd_);
+    const char *begin = data.data();
+    const char *in = begin;
+    const char *end = in + data.size();
+    for (;;) {
+      const char *record = in;
+      std::uint32_t length{}, crc{};
+      if (!durable_codec<std::uint32_t>::decode(in, end, length) ||
+          !durable_codec<std::uint32_t>::decode(in, end, crc) ||
+          std::size_t(end - in) < length || crc != Crc32(in, length) ||
+          !Replay(in, in + length, snapshot_seq)) {
+        in = record;
+        break;
+      }
+      in += length;
+    }
+    if (in != end && ::ftruncate(log_fd_, in - begin) != 0) {
+      throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+  }
+
+  bool Replay(const char *in, const char *end, std::uint64_t snapshot_seq) {
+    std::uint64_t seq{};
+    std::uint8_t op{};
+    Key key{};
+    if (!durable_codec<std::uint64_t>::decode(in, end, seq) ||
+        !durable_codec<std::uint8_t>::decode(in, end, op) ||
+        !KeyCodec::decode(in, end, key)) {
+      return false;
+    }
+    if (op == kPut) {
+      T value{};
+      if (!ValueCodec::decode(in, end, value)) return false;
+      if (seq > snapshot_seq) {
+        table_.insert_or_assign(std::move(key), std::move(value));
+      }
+    } else if (op == kErase) {
+      if (seq > snapshot_seq) table_.erase(key);
+    } else {
+      return false;
+    }
+    if (seq > last_seq_) last_seq_ = seq;
+    ++log_records_;
+    return true;
+  }
+};  // class durable_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_DURABLE_MAP_H_
@@ -0,0 +1,141 @@
+#ifndef CONTAINERS_SRC_S21_EPOCH_H_
+#define CONTAINERS_SRC_S21_EPOCH_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace s21 {
+//  Epoch based reclamation shared by the lock-free readers of the
+//  concurrent containers. A reader pins the current epoch in a slot of its
+//  own for the duration of an EpochGuard; memory unlinked in epoch E may be
+//  freed once no slot is pinned at E or earlier.
+class EpochDomain {
+ public:
+  using epoch_type = std::uint64_t;
+
+  //  One per thread, padded so readers never share a cache line
+  struct alignas(64) Slot {
+    std::atomic<epoch_type> epoch{};
+    std::atomic<bool> in_use{};
+    Slot *next{};
+  };
+
+  EpochDomain() = default;
+  EpochDomain(const EpochDomain &) = delete;
+  EpochDomain &operator=(const EpochDomain &) = delete;
+  ~EpochDomain() {
+    Slot *slot = slots_.load();
+    while (slot != nullptr) {
+      Slot *next = slot->next;
+      delete slot;
+      slot = next;
+    }
+  }
+
+  //  Takes a free slot or adds a new one, slots are never unlinked
+  Slot *acquire() {
+    for (Slot *slot = slots_.load(std::memory_order_acquire); slot != nullptr;
+         slot = slot->next) {
+      bool expected = false;
+      if (!slot->in_use.load(std::memory_order_relaxed) &&
+          slot->in_use.compare_exchange_strong(expected, true)) {
+        return slot;
+      }
+    }
+    Slot *slot = new Slot;
+    slot->in_use.store(true, std::memory_order_relaxed);
+    slot->next = slots_.load(std::memory_order_relaxed);
+    while (!slots_.compare_exchange_weak(slot->next, slot,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+    }
+    return slot;
+  }
+
+  void release(Slot *slot) {
+    slot->epoch.store(0, std::memory_order_release);
+    slot->in_use.store(false, std::memory_order_release);
+  }
+
+  //  Pins the current epoch; the store is ordered before the reader's loads
+  void enter(Slot *slot) {
+    slot->epoch.store(epoch_.load(std::memory_order_acquire),
+                      std::memory_order_seq_cst);
+  }
+
+  void exit(Slot *slot) { slot->epoch.store(0, std::memory_order_release); }
+
+  //  Called by a writer after unlinking memory, returns the epoch it was
+  //  retired in and moves the clock past it
+  epoch_type retire_epoch() {
+    return epoch_.fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  //  True once no reader can still see memory retired in `retired`
+  bool safe(epoch_type retired) const {
+    for (Slot *slot = slots_.load(std::memory_order_acquire); slot != nullptr;
+         slot = slot->next) {
+      epoch_type pinned = slot->epoch.load(std::memory_order_seq_cst);
+      if (pinned != 0 && pinned <= retired) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //  Oldest pinned epoch, or the maximum if no reader is pinned; memory
+  //  retired in any earlier epoch is safe. One pass for a whole batch.
+  epoch_type oldest() const {
+    epoch_type oldest = ~epoch_type{};
+    for (Slot *slot = slots_.load(std::memory_order_acquire); slot != nullptr;
+         slot = slot->next) {
+      epoch_type pinned = slot->epoch.load(std::memory_order_seq_cst);
+      if (pinned != 0 && pinned < oldest) oldest = pinned;
+    }
+    return oldest;
+  }
+
+ private:
+  //  Starts at 1, 0 marks an idle slot
+  std::atomic<epoch_type> epoch_{1};
+  std::atomic<Slot *> slots_{};
+};
+
+inline EpochDomain &epoch_domain() {
+  static EpochDomain domain;
+  return domain;
+}
+
+//  Keeps the calling thread pinned while alive, guards may nest
+class EpochGuard {
+ public:
+  EpochGuard() {
+    Local &local = LocalSlot();
+    if (local.depth++ == 0) {
+      epoch_domain().enter(local.slot);
+    }
+  }
+  ~EpochGuard() {
+    Local &local = LocalSlot();
+    if (--local.depth == 0) {
+      epoch_domain().exit(local.slot);
+    }
+  }
+  EpochGuard(const EpochGuard &) = delete;
+  EpochGuard &operator=(const EpochGuard &) = delete;
+
+ private:
+  struct Local {
+    EpochDomain::Slot *slot = epoch_domain().acquire();
+    std::size_t depth{};
+    ~Local() { epoch_domain().release(slot); }
+  };
+
+  static Local &LocalSlot() {
+    thread_local Local local;
+    return local;
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_EPOCH_H_
@@ -0,0 +1,299 @@
+#ifndef CONTAINERS_SRC_S21_HASH_H_
+#define CONTAINERS_SRC_S21_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+//  Set by hashers whose every output bit depends on every input bit, so a
+//  table may use any slice of the result as is instead of mixing it again
+template <class H, class = void>
+struct IsAvalanching : std::false_type {};
+template <class H>
+struct IsAvalanching<H, std::void_t<typename H::is_avalanching>>
+    : std::true_type {};
+
+//  Key material for the long input stripes, splitmix64 output
+struct HashSecret {
+  static constexpr std::size_t kSize = 192;
+  constexpr HashSecret() : bytes() {
+    std::uint64_t state = 0x243F6A8885A308D3ull;
+    for (std::size_t i = 0; i < kSize; i += 8) {
+      std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+      z ^= z >> 31;
+      for (std::size_t b = 0; b < 8; ++b) {
+        bytes[i + b] = static_cast<unsigned char>(z >> (8 * b));
+      }
+    }
+  }
+  unsigned char bytes[kSize];
+};
+inline constexpr HashSecret kHashSecret{};
+
+//  Byte string hashing behind s21::hash. Up to kLongInput bytes take the
+//  wyhash scheme: 16 input bytes per 64x64->128 multiply. Longer inputs
+//  take the XXH3 scheme of eight 64-bit accumulators fed a 64-byte stripe
+//  at a time, which maps onto SSE2 or AVX2 lanes. Both paths give the
+//  same value on every build; inputs are read as little endian.
+class ByteHasher {
+ public:
+  static constexpr std::size_t kLongInput = 256;
+
+  static std::uint64_t Hash(const void *data, std::size_t len,
+                            std::uint64_t seed) {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    return len <= kLongInput ? Short(p, len, seed) : Long<true>(p, len, seed);
+  }
+
+  //  128-bit product folded to 64 bits
+  static std::uint64_t Mum(std::uint64_t a, std::uint64_t b) {
+    unsigned __int128 product = (unsigned __int128)a * b;
+    return std::uint64_t(product) ^ std::uint64_t(product >> 64);
+  }
+
+  //  The stripe loop with or without vector instructions, for tests
+  template <bool Simd>
+  static std::uint64_t Long(const unsigned char *p, std::size_t len,
+                            std::uint64_t seed) {
+    alignas(32) std::uint64_t acc[8];
+    for (int i = 0; i < 8; ++i) {
+      acc[i] = Read64(kHashSecret.bytes + 8 * i) ^ seed;
+    }
+    constexpr std::size_t kStripes = (kSecretSize - 64) / 8;
+    constexpr std::size_t kBlock = 64 * kStripes;
+    std::size_t blocks = (len - 1) / kBlock;
+    for (std::size_t n = 0; n < blocks; ++n, p += kBlock) {
+      for (std::size_t s = 0; s < kStripes; ++s) {
+        Accumulate<Simd>(acc, p + 64 * s, kHashSecret.bytes + 8 * s);
+      }
+      Scramble(acc);
+    }
+    std::size_t tail = len - blocks * kBlock;
+    for (std::size_t s = 0; s < (tail - 1) / 64; ++s) {
+      Accumulate<Simd>(acc, p + 64 * s, kHashSecret.bytes + 8 * s);
+    }
+    //  The last 64 bytes, overlapping what came before
+    Accumulate<Simd>(acc, p + tail - 64, kHashSecret.bytes + kSecretSize - 71);
+    std::uint64_t result = len * 0x9E3779B185EBCA87ull;
+    for (int i = 0; i < 4; ++i) {
+      result += Mum(acc[2 * i] ^ Read64(kHashSecret.bytes + 11 + 16 * i),
+                    acc[2 * i + 1] ^ Read64(kHashSecret.bytes + 19 + 16 * i));
+    }
+    return Finish(result);
+  }
+
+ private:
+  static constexpr std::size_t kSecretSize = HashSecret::kSize;
+  static constexpr std::uint64_t kPrime[4] = {
+      0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull,
+      0x589965cc75374cc3ull};
+
+  static std::uint64_t Read64(const unsigned char *p) {
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+  static std::uint64_t Read32(const unsigned char *p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+
+  static std::uint64_t Finish(std::uint64_t h) {
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ull;
+    return h ^ (h >> 32);
+  }
+
+  static std::uint64_t Short(const unsigned char *p, std::size_t len,
+                             std::uint64_t seed) {
+    seed ^= Mum(seed ^ kPrime[0], kPrime[1]);
+    std::uint64_t a = 0, b = 0;
+    if (len <= 16) {
+      if (len >= 4) {
+        std::size_t shift = (len >> 3) << 2;
+        a = (Read32(p) << 32) | Read32(p + shift);
+        b = (Read32(p + len - 4) << 32) | Read32(p + len - 4 - shift);
+      } else if (len > 0) {
+        a = (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[len >> 1]) << 8) |
+            p[len - 1];
+      }
+    } else {
+      std::size_t i = len;
+      if (i > 48) {
+        std::uint64_t lane1 = seed, lane2 = seed;
+        do {
+          seed = Mum(Read64(p) ^ kPrime[1], Read64(p + 8) ^ seed);
+          lane1 = Mum(Read64(p + 16) ^ kPrime[2], Read64(p + 24) ^ lane1);
+          lane2 = Mum(Read64(p + 32) ^ kPrime[3], Read64(p + 40) ^ lane2);
+          p += 48;
+          i -= 48;
+        } while (i > 48);
+        seed ^= lane1 ^ lane2;
+      }
+      for (; i > 16; i -= 16, p += 16) {
+        seed = Mum(Read64(p) ^ kPrime[1], Read64(p + 8) ^ seed);
+      }
+      a = Read64(p + i - 16);
+      b = Read64(p + i - 8);
+    }
+    unsigned __int128 product =
+        (unsigned __int128)(a ^ kPrime[1]) * (b ^ seed);
+    return Mum(std::uint64_t(product) ^ kPrime[0] ^ len,
+               std::uint64_t(product >> 64) ^ kPrime[1]);
+  }
+
+  //  Per 64-bit lane: acc[i] += lo32(d ^ k) * hi32(d ^ k), acc[i ^ 1] += d
+  template <bool Simd>
+  static void Accumulate(std::uint64_t *acc, const unsigned char *p,
+                         const unsigned char *key) {
+#if defined(__AVX2__)
+    if (Simd) {
+      for (int i = 0; i < 2; ++i) {
+        __m256i data = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(p) + i);
+        __m256i mixed = _mm256_xor_si256(
+            data,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key) + i));
+        __m256i product = _mm256_mul_epu32(
+            mixed, _mm256_shuffle_epi32(mixed, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m256i *lanes = reinterpret_cast<__m256i *>(acc) + i;
+        _mm256_store_si256(
+            lanes, _mm256_add_epi64(
+                       _mm256_load_si256(lanes),
+                       _mm256_add_epi64(product,
+                                        _mm256_shuffle_epi32(
+                                            data, _MM_SHUFFLE(1, 0, 3, 2)))));
+      }
+      return;
+    }
+#elif defined(__SSE2__)
+    if (Simd) {
+      for (int i = 0; i < 4; ++i) {
+        __m128i data =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p) + i);
+        __m128i mixed = _mm_xor_si128(
+            data, _mm_loadu_si128(reinterpret_cast<const __m128i *>(key) + i));
+        __m128i product = _mm_mul_epu32(
+            mixed, _mm_shuffle_epi32(mixed, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m128i *lanes = reinterpret_cast<__m128i *>(acc) + i;
+        _mm_store_si128(
+            lanes,
+            _mm_add_epi64(_mm_load_si128(lanes),
+                          _mm_add_epi64(product, _mm_shuffle_epi32(
+                                                     data, _MM_SHUFFLE(
+                                                               1, 0, 3, 2)))));
+      }
+      return;
+    }
+#endif
+    for (int i = 0; i < 8; ++i) {
+      std::uint64_t data = Read64(p + 8 * i);
+      std::uint64_t mixed = data ^ Read64(key + 8 * i);
+      acc[i] += (mixed & 0xFFFFFFFFull) * (mixed >> 32);
+      acc[i ^ 1] += data;
+    }
+  }
+
+  //  Once per block, so high accumulator bits flow back down
+  static void Scramble(std::uint64_t *acc) {
+    for (int i = 0; i < 8; ++i) {
+      std::uint64_t value = acc[i] ^ (acc[i] >> 47);
+      value ^= Read64(kHashSecret.bytes + kSecretSize - 64 + 8 * i);
+      acc[i] = value * 0x9E3779B1ull;
+    }
+  }
+};
+
+//  Hash of a byte string; the same bytes and seed give the same value on
+//  every build
+inline std::uint64_t hash_bytes(const void *data, std::size_t len,
+                                std::uint64_t seed = 0) {
+  return ByteHasher::Hash(data, len, seed);
+}
+
+//  Bijective 64-bit mixer with full avalanche, two multiplies
+inline std::uint64_t hash_mix(std::uint64_t x) {
+  x ^= x >> 32;
+  x *= 0xD6E8FEB86659FD93ull;
+  x ^= x >> 32;
+  x *= 0xD6E8FEB86659FD93ull;
+  return x ^ (x >> 32);
+}
+
+//  Default hasher of the s21 hash containers. Every result is fully
+//  mixed, unlike std::hash, which is the identity on integers in the
+//  common standard libraries. Types without a specialization below go
+//  through std::hash and then hash_mix.
+template <class T, class = void>
+struct hash {
+  using is_avalanching = void;
+  std::size_t operator()(const T &value) const {
+    return hash_mix(std::hash<T>()(value));
+  }
+};
+
+template <class T>
+struct hash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>> {
+  using is_avalanching = void;
+  std::size_t operator()(T value) const {
+    return hash_mix(static_cast<std::uint64_t>(value));
+  }
+};
+
+template <class T>
+struct hash<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+  using is_avalanching = void;
+  std::size_t operator()(T value) const {
+    //  0.0 and -0.0 compare equal
+    if (value == 0) return hash_mix(0);
+    return hash_bytes(&value, kValueBytes);
+  }
+
+ private:
+  //  An x87 long double holds 10 bytes, the rest of its size is padding
+  //  that equal values need not share
+  static constexpr std::size_t kValueBytes =
+      std::numeric_limits<T>::digits == 64 ? 10 : sizeof(T);
+};
+
+template <class T>
+struct hash<T *> {
+  using is_avalanching = void;
+  std::size_t operator()(T *value) const {
+    return hash_mix(reinterpret_cast<std::uintptr_t>(value));
+  }
+};
+
+//  Transparent over every string type of one character type, so tables
+//  keyed by std::string can be probed with a string_view or literal
+template <class CharT>
+struct StringHash {
+  using is_avalanching = void;
+  using is_transparent = void;
+  std::size_t operator()(std::basic_string_view<CharT> text) const {
+    return hash_bytes(text.data(), text.size() * sizeof(CharT));
+  }
+};
+
+template <class CharT, class Traits, class Alloc>
+struct hash<std::basic_string<CharT, Traits, Alloc>> : StringHash<CharT> {};
+template <class CharT, class Traits>
+struct hash<std::basic_string_view<CharT, Traits>> : StringHash<CharT> {};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_HASH_H_
@@ -0,0 +1,718 @@
+#ifndef CONTAINERS_SRC_S21_HASH_TABLE_H_
+#define CONTAINERS_SRC_S21_HASH_TABLE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "s21_hash.h"
+
+namespace s21 {
+//  Sixteen control bytes, probed at once. A full slot's byte holds the low
+//  7 bits of its hash (H2); empty and deleted bytes are negative.
+class HashGroup {
+ public:
+  static constexpr std::size_t kWidth = 16;
+  static constexpr std::int8_t kEmpty = -128;
+  static constexpr std::int8_t kDeleted = -2;
+
+#ifdef __SSE2__
+  explicit HashGroup(const std::int8_t *ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+
+  //  Bit i is set if byte i equals h2
+  std::uint32_t Match(std::int8_t h2) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+  }
+  std::uint32_t MatchEmpty() const { return Match(kEmpty); }
+  //  Empty or deleted
+  std::uint32_t MatchFree() const {
+    return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_));
+  }
+
+ private:
+  __m128i ctrl_;
+#else
+  explicit HashGroup(const std::int8_t *ctrl) {
+    std::memcpy(ctrl_, ctrl, kWidth);
+  }
+
+  std::uint32_t Match(std::int8_t h2) const {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) mask |= (ctrl_[i] == h2) << i;
+    return mask;
+  }
+  std::uint32_t MatchEmpty() const { return Match(kEmpty); }
+  std::uint32_t MatchFree() const {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) mask |= (ctrl_[i] < -1) << i;
+    return mask;
+  }
+
+ private:
+  std::int8_t ctrl_[kWidth];
+#endif
+};
+
+template <class F, class = void>
+struct IsTransparent : std::false_type {};
+template <class F>
+struct IsTransparent<F, std::void_t<typename F::is_transparent>>
+    : std::true_type {};
+
+//  Open addressing core shared by unordered_map and unordered_set, the
+//  hash counterpart of BinaryTree. Values sit in one slot array next to
+//  a control byte array; a lookup compares 16 control bytes per step with
+//  SSE2 and touches a slot only on an H2 match. Groups are probed
+//  quadratically from the hash's home slot. Erase leaves a tombstone
+//  unless the slot's neighbourhood never filled up; tombstones are purged
+//  by an in-place rehash instead of growing when they pile up.
+//
+//  With Incremental, growing only allocates the new arrays. The old ones
+//  stay readable and every insert moves the next kMigrateSlots old slots
+//  over, so no single insert pays for the whole table; so does an erase
+//  by key, so erase-only workloads drain it too. Lookups check both
+//  tables until the old one is drained.
+template <class Key, class Value, class KeyOf, class Hash, class KeyEqual,
+          class Allocator, bool Incremental = false>
+class HashTable {
+ public:
+  template <bool Const>
+  class HashIterator;
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Value>;
+  using iterator = HashIterator<false>;
+  using const_iterator = HashIterator<true>;
+
+ protected:
+  //  Enables the K overloads of find and erase when Hash and KeyEqual both
+  //  declare is_transparent, so a string table can be probed with a
+  //  string_view without building a key
+  template <class K>
+  using Heterogeneous = std::enable_if_t<
+      IsTransparent<Hash>::value && IsTransparent<KeyEqual>::value &&
+      !std::is_convertible_v<K, const_iterator>>;
+
+ public:
+  template <bool Const>
+  class HashIterator {
+    friend class HashTable;
+
+   public:
+    using value_type = HashTable::value_type;
+    using pointer = std::conditional_t<Const, const Value *, Value *>;
+    using reference = std::conditional_t<Const, const Value &, Value &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    HashIterator() {}
+    template <bool C = Const, class = std::enable_if_t<C>>
+    HashIterator(const HashIterator<false> &other)
+        : ctrl_(other.ctrl_),
+          slot_(other.slot_),
+          end_(other.end_),
+          then_ctrl_(other.then_ctrl_),
+          then_slot_(other.then_slot_),
+          then_end_(other.then_end_) {}
+
+    reference operator*() const { return *slot_; }
+    pointer operator->() const { return slot_; }
+    bool operator==(const HashIterator &other) const {
+      return ctrl_ == other.ctrl_;
+    }
+    bool operator!=(const HashIterator &other) const {
+      return ctrl_ != other.ctrl_;
+    }
+    HashIterator &operator++() {
+      ++ctrl_;
+      ++slot_;
+      SkipFree();
+      return *this;
+    }
+    HashIterator operator++(int) {
+      HashIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+   private:
+    HashIterator(const std::int8_t *ctrl, Value *slot, const std::int8_t *end,
+                 const std::int8_t *then_ctrl = nullptr,
+                 Value *then_slot = nullptr,
+                 const std::int8_t *then_end = nullptr)
+        : ctrl_(ctrl),
+          slot_(slot),
+          end_(end),
+          then_ctrl_(then_ctrl),
+          then_slot_(then_slot),
+          then_end_(then_end) {}
+    //  Moves on to the current table at the end of the old one
+    void SkipFree() {
+      for (;;) {
+        while (ctrl_ != end_ && *ctrl_ < 0) {
+          ++ctrl_;
+          ++slot_;
+        }
+        if (ctrl_ != end_ || then_ctrl_ == nullptr) return;
+        ctrl_ = then_ctrl_;
+        slot_ = then_slot_;
+        end_ = then_end_;
+        then_ctrl_ = nullptr;
+      }
+    }
+    const std::int8_t *ctrl_{};
+    Value *slot_{};
+    const std::int8_t *end_{};
+    //  The current table, while iterating the old one of a migration
+    const std::int8_t *then_ctrl_{};
+    Value *then_slot_{};
+    const std::int8_t *then_end_{};
+  };  //  class HashIterator
+
+  HashTable() {}
+  HashTable(std::initializer_list<Value> const &items) {
+    try {
+      reserve(items.size());
+      for (auto it = items.begin(); it != items.end(); ++it) insert(*it);
+    } catch (...) {
+      Destroy();
+      throw;
+    }
+  }
+  HashTable(const HashTable &other)
+      : hash_(other.hash_), equal_(other.equal_), allocator_(other.allocator_) {
+    try {
+      CopyFrom(other);
+    } catch (...) {
+      Destroy();
+      throw;
+    }
+  }
+  HashTable(HashTable &&other) noexcept { swap(other); }
+  HashTable &operator=(const HashTable &other) {
+    if (this != &other) {
+      HashTable copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  HashTable &operator=(HashTable &&other) noexcept {
+    if (this != &other) {
+      HashTable empty;
+      swap(empty);
+      swap(other);
+    }
+    return *this;
+  }
+  ~HashTable() { Destroy(); }
+
+  iterator begin() { return Begin<false>(); }
+  iterator end() { return iterator(EndCtrl(), slots_ + capacity_, EndCtrl()); }
+  const_iterator begin() const { return Begin<true>(); }
+  const_iterator end() const {
+    return const_iterator(EndCtrl(), slots_ + capacity_, EndCtrl());
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return std::allocator_traits<allocator_type>::max_size(allocator_) / 2;
+  }
+  size_type bucket_count() const { return capacity_; }
+  float load_factor() const {
+    return capacity_ ? float(size_) / float(capacity_) : 0.0f;
+  }
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+
+  void clear() {
+    DestroySlots();
+    FreeOld();
+    if (capacity_ != 0) {
+      std::memset(ctrl_, HashGroup::kEmpty, capacity_ + HashGroup::kWidth);
+    }
+    size_ = 0;
+    growth_left_ = MaxLoad(capacity_);
+  }
+
+  //  Room for `count` values without a rehash
+  void reserve(size_type count) {
+    if (count > MaxLoad(capacity_)) Rehash(CapacityFor(count));
+  }
+
+  //  At least `count` slots, never below what size() needs
+  void rehash(size_type count) {
+    FinishMigration();
+    size_type capacity = CapacityFor(std::max(count * 7 / 8, size_));
+    if (capacity != capacity_ || growth_left_ + size_ < MaxLoad(capacity_)) {
+      Rehash(capacity);
+    }
+  }
+
+  //  True while an incremental resize still has old slots to move
+  bool migrating() const { return old_ctrl_ != nullptr; }
+
+  iterator find(const Key &key) { return FindIt<false>(key); }
+  const_iterator find(const Key &key) const { return FindIt<true>(key); }
+  bool contains(const Key &key) const { return Find(key) != nullptr; }
+  size_type count(const Key &key) const { return contains(key); }
+  template <class K, class = Heterogeneous<K>>
+  iterator find(const K &key) {
+    return FindIt<false>(key);
+  }
+  template <class K, class = Heterogeneous<K>>
+  const_iterator find(const K &key) const {
+    return FindIt<true>(key);
+  }
+  template <class K, class = Heterogeneous<K>>
+  bool contains(const K &key) const {
+    return Find(key) != nullptr;
+  }
+  template <class K, class = Heterogeneous<K>>
+  size_type count(const K &key) const {
+    return contains(key);
+  }
+
+  std::pair<iterator, bool> insert(const Value &value) {
+    return TryEmplace(KeyOf()(value), value);
+  }
+  std::pair<iterator, bool> insert(Value &&value) {
+    return TryEmplace(KeyOf()(value), std::move(value));
+  }
+  template <class InputIt, class = typename std::iterator_traits<
+                                InputIt>::iterator_category>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  void erase(const_iterator pos) { EraseSlot(pos.slot_); }
+  size_type erase(const Key &key) { return EraseKey(key); }
+  template <class K, class = Heterogeneous<K>>
+  size_type erase(const K &key) {
+    return EraseKey(key);
+  }
+
+  void swap(HashTable &other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(old_ctrl_, other.old_ctrl_);
+    std::swap(old_slots_, other.old_slots_);
+    std::swap(old_capacity_, other.old_capacity_);
+    std::swap(migrated_, other.migrated_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+    std::swap(allocator_, other.allocator_);
+  }
+
+ protected:
+  using ctrl_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<std::int8_t>;
+  static constexpr size_type kNotFound = ~size_type{};
+  //  Old slots an insert moves during an incremental resize. Growth
+  //  doubles the table, so the old one drains long before the new fills.
+  static constexpr size_type kMigrateSlots = 2 * HashGroup::kWidth;
+
+  std::int8_t *ctrl_{};
+  Value *slots_{};
+  //  A power of two, at least one group wide, or 0 before the first insert
+  size_type capacity_{};
+  //  Values in both tables
+  size_type size_{};
+  //  Inserts into empty slots left before a rehash
+  size_type growth_left_{};
+  //  Arrays being drained by an incremental resize, null otherwise
+  std::int8_t *old_ctrl_{};
+  Value *old_slots_{};
+  size_type old_capacity_{};
+  //  Old slots below this index have been moved
+  size_type migrated_{};
+  Hash hash_{};
+  KeyEqual equal_{};
+  allocator_type allocator_{};
+
+  //  Spreads the user hash over all 64 bits, so identity hashes of
+  //  integers still vary in H1 and H2; skipped for avalanching hashers
+  static std::uint64_t Mix(std::uint64_t hash) {
+    if constexpr (IsAvalanching<Hash>::value) return hash;
+    unsigned __int128 product =
+        (unsigned __int128)hash * 0x9E3779B97F4A7C15ull;
+    return std::uint64_t(product) ^ std::uint64_t(product >> 64);
+  }
+  static size_type H1(std::uint64_t hash) { return hash >> 7; }
+  static std::int8_t H2(std::uint64_t hash) { return hash & 0x7F; }
+
+  //  Keep the table at most 7/8 full
+  static size_type MaxLoad(size_type capacity) {
+    return capacity - capacity / 8;
+  }
+
+  static size_type CapacityFor(size_type count) {
+    size_type capacity = HashGroup::kWidth;
+    while (MaxLoad(capacity) < count) capacity *= 2;
+    return capacity;
+  }
+
+  const std::int8_t *EndCtrl() const { return ctrl_ + capacity_; }
+
+  bool InOld(const Value *slot) const {
+    return old_slots_ != nullptr && !std::less<>()(slot, old_slots_) &&
+           std::less<>()(slot, old_slots_ + old_capacity_);
+  }
+
+  template <bool Const = false>
+  HashIterator<Const> IteratorAt(Value *slot) const {
+    if (Incremental && InOld(slot)) {
+      return HashIterator<Const>(old_ctrl_ + (slot - old_slots_), slot,
+                                 old_ctrl_ + old_capacity_, ctrl_, slots_,
+                                 EndCtrl());
+    }
+    return HashIterator<Const>(ctrl_ + (slot - slots_), slot, EndCtrl());
+  }
+
+  template <bool Const, class K>
+  HashIterator<Const> FindIt(const K &key) const {
+    Value *slot = Find(key);
+    if (slot == nullptr) {
+      return HashIterator<Const>(EndCtrl(), slots_ + capacity_, EndCtrl());
+    }
+    return IteratorAt<Const>(slot);
+  }
+
+  template <class K>
+  size_type EraseKey(const K &key) {
+    Value *slot = Find(key);
+    if (slot == nullptr) return 0;
+    EraseSlot(slot);
+    //  Erase by iterator keeps other iterators valid and does not migrate;
+    //  a step that could throw is left to the inserts
+    if constexpr (Incremental && std::is_nothrow_move_constructible_v<Value>) {
+      MigrateStep();
+    }
+    return 1;
+  }
+
+  template <bool Const>
+  HashIterator<Const> Begin() const {
+    HashIterator<Const> it(ctrl_, slots_, EndCtrl());
+    if (Incremental && old_ctrl_ != nullptr) {
+      it = HashIterator<Const>(old_ctrl_ + migrated_, old_slots_ + migrated_,
+                               old_ctrl_ + old_capacity_, ctrl_, slots_,
+                               EndCtrl());
+    }
+    it.SkipFree();
+    return it;
+  }
+
+  template <class K>
+  std::uint64_t HashOf(const K &key) const {
+    return Mix(hash_(key));
+  }
+
+  //  Index of the key in the given arrays or kNotFound; stops at the first
+  //  group with an empty byte
+  template <class K>
+  size_type FindIndex(const std::int8_t *ctrl, const Value *slots,
+                      size_type capacity, const K &key,
+                      std::uint64_t hash) const {
+    if (capacity == 0) return kNotFound;
+    size_type mask = capacity - 1;
+    size_type pos = H1(hash) & mask;
+    for (size_type step = HashGroup::kWidth;; step += HashGroup::kWidth) {
+      HashGroup group(ctrl + pos);
+      for (std::uint32_t match = group.Match(H2(hash)); match != 0;
+           match &= match - 1) {
+        size_type index = (pos + __builtin_ctz(match)) & mask;
+        if (equal_(KeyOf()(slots[index]), key)) return index;
+      }
+      if (group.MatchEmpty() != 0) return kNotFound;
+      pos = (pos + step) & mask;
+    }
+  }
+
+  //  Slot holding the key in either table, or nullptr
+  template <class K>
+  Value *Find(const K &key, std::uint64_t hash) const {
+    size_type index = FindIndex(ctrl_, slots_, capacity_, key, hash);
+    if (index != kNotFound) return slots_ + index;
+    if (Incremental && old_ctrl_ != nullptr) {
+      index = FindIndex(old_ctrl_, old_slots_, old_capacity_, key, hash);
+      if (index != kNotFound) return old_slots_ + index;
+    }
+    return nullptr;
+  }
+  template <class K>
+  Value *Find(const K &key) const {
+    return size_ == 0 ? nullptr : Find(key, HashOf(key));
+  }
+
+  //  First empty or deleted slot on the hash's probe sequence
+  size_type FindFree(std::uint64_t hash) const {
+    size_type mask = capacity_ - 1;
+    size_type pos = H1(hash) & mask;
+    for (size_type step = HashGroup::kWidth;; step += HashGroup::kWidth) {
+      std::uint32_t free = HashGroup(ctrl_ + pos).MatchFree();
+      if (free != 0) return (pos + __builtin_ctz(free)) & mask;
+      pos = (pos + step) & mask;
+    }
+  }
+
+  //  The first kWidth bytes are mirrored past the end, so a group read at
+  //  any slot sees the wrapped-around bytes
+  static void SetCtrl(std::int8_t *ctrl, size_type capacity, size_type index,
+                      std::int8_t value) {
+    ctrl[index] = value;
+    if (index < HashGroup::kWidth) ctrl[capacity + index] = value;
+  }
+  void SetCtrl(size_type index, std::int8_t value) {
+    SetCtrl(ctrl_, capacity_, index, value);
+  }
+
+  //  Builds the value from args only if the key is missing. The value is
+  //  built before any old value moves, so args may refer to one of them.
+  template <class K, class... Args>
+  std::pair<iterator, bool> TryEmplace(const K &key, Args &&...args) {
+    std::uint64_t hash = HashOf(key);
+    if (Value *slot = Find(key, hash)) {
+      return std::make_pair(IteratorAt(slot), false);
+    }
+    auto build = [&](Value *slot) {
+      std::allocator_traits<allocator_type>::construct(
+          allocator_, slot, std::forward<Args>(args)...);
+      return true;
+    };
+    if (capacity_ == 0) Rehash(HashGroup::kWidth);
+    size_type index = FindFree(hash);
+    if (growth_left_ == 0 && ctrl_[index] == HashGroup::kEmpty) {
+      //  Mostly tombstones: purge them at the same size, otherwise grow
+      size_type capacity =
+          size_ * 2 <= MaxLoad(capacity_) ? capacity_ : capacity_ * 2;
+      if (!Incremental) {
+        index = Rehash(capacity, hash, build);
+        return std::make_pair(IteratorAt(slots_ + index), true);
+      }
+      //  The old arrays stay where they are until MigrateStep
+      StartMigration(capacity);
+      index = FindFree(hash);
+    }
+    build(slots_ + index);
+    if (ctrl_[index] == HashGroup::kEmpty) --growth_left_;
+    SetCtrl(index, H2(hash));
+    ++size_;
+    if (Incremental) {
+      try {
+        MigrateStep();
+      } catch (...) {
+        //  Values moved by this step may have probed past the new one
+        std::allocator_traits<allocator_type>::destroy(allocator_,
+                                                       slots_ + index);
+        SetCtrl(index, HashGroup::kDeleted);
+        --size_;
+        throw;
+      }
+    }
+    return std::make_pair(IteratorAt(slots_ + index), true);
+  }
+
+  void EraseSlot(Value *slot) {
+    if (Incremental && InOld(slot)) {
+      //  Nothing is inserted into the old table, a tombstone will do
+      std::allocator_traits<allocator_type>::destroy(allocator_, slot);
+      --size_;
+      SetCtrl(old_ctrl_, old_capacity_, slot - old_slots_,
+              HashGroup::kDeleted);
+      return;
+    }
+    EraseAt(slot - slots_);
+  }
+
+  void EraseAt(size_type index) {
+    std::allocator_traits<allocator_type>::destroy(allocator_, slots_ + index);
+    --size_;
+    //  If no probe ever passed this slot on a full group, it can go back to
+    //  empty: some group covering it still has an empty byte on each side
+    size_type before = (index - HashGroup::kWidth) & (capacity_ - 1);
+    std::uint32_t empty_after = HashGroup(ctrl_ + index).MatchEmpty();
+    std::uint32_t empty_before = HashGroup(ctrl_ + before).MatchEmpty();
+    bool never_full =
+        empty_after != 0 && empty_before != 0 &&
+        size_type(__builtin_ctz(empty_after) +
+                  (__builtin_clz(empty_before) - 16)) < HashGroup::kWidth;
+    if (never_full) {
+      SetCtrl(index, HashGroup::kEmpty);
+      ++growth_left_;
+    } else {
+      SetCtrl(index, HashGroup::kDeleted);
+    }
+  }
+
+  //  Empty arrays of `capacity` slots, all control bytes kEmpty
+  void Allocate(size_type capacity, std::int8_t *&ctrl, Value *&slots) {
+    ctrl_allocator ctrl_alloc(allocator_);
+    ctrl = ctrl_alloc.allocate(capacity + HashGroup::kWidth);
+    try {
+      slots = allocator_.allocate(capacity);
+    } catch (...) {
+      ctrl_alloc.deallocate(ctrl, capacity + HashGroup::kWidth);
+      throw;
+    }
+    std::memset(ctrl, HashGroup::kEmpty, capacity + HashGroup::kWidth);
+  }
+
+  void Deallocate(std::int8_t *ctrl, Value *slots, size_type capacity) {
+    ctrl_allocator(allocator_).deallocate(ctrl, capacity + HashGroup::kWidth);
+    allocator_.deallocate(slots, capacity);
+  }
+
+  void Rehash(size_type capacity) {
+    Rehash(capacity, 0, [](Value *) { return false; });
+  }
+
+  //  Moves every value into fresh arrays of `capacity` slots; strong
+  //  guarantee, values are copied when their move could throw. build(slot)
+  //  may construct a new value with `hash` and returns whether it did; it
+  //  runs before the old values move, so its arguments may refer to them.
+  //  Returns the new value's index.
+  template <class Build>
+  size_type Rehash(size_type capacity, std::uint64_t hash, Build build) {
+    FinishMigration();
+    HashTable next;
+    Allocate(capacity, next.ctrl_, next.slots_);
+    next.capacity_ = capacity;
+    next.growth_left_ = MaxLoad(capacity);
+    next.allocator_ = allocator_;
+    size_type built = next.FindFree(hash);
+    if (build(next.slots_ + built)) {
+      next.SetCtrl(built, H2(hash));
+      ++next.size_;
+      --next.growth_left_;
+    }
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] < 0) continue;
+      std::uint64_t hash = HashOf(KeyOf()(slots_[i]));
+      size_type index = next.FindFree(hash);
+      std::allocator_traits<allocator_type>::construct(
+          allocator_, next.slots_ + index, std::move_if_noexcept(slots_[i]));
+      next.SetCtrl(index, H2(hash));
+      ++next.size_;
+      --next.growth_left_;
+    }
+    std::swap(ctrl_, next.ctrl_);
+    std::swap(slots_, next.slots_);
+    std::swap(capacity_, next.capacity_);
+    std::swap(size_, next.size_);
+    std::swap(growth_left_, next.growth_left_);
+    return built;
+  }
+
+  //  Makes the current arrays the old ones and starts over with empty
+  //  arrays of `capacity` slots
+  void StartMigration(size_type capacity) {
+    FinishMigration();
+    std::int8_t *ctrl;
+    Value *slots;
+    Allocate(capacity, ctrl, slots);
+    old_ctrl_ = ctrl_;
+    old_slots_ = slots_;
+    old_capacity_ = capacity_;
+    migrated_ = 0;
+    ctrl_ = ctrl;
+    slots_ = slots;
+    capacity_ = capacity;
+    growth_left_ = MaxLoad(capacity);
+  }
+
+  //  Moves the next kMigrateSlots old slots, freeing the old arrays once
+  //  they are drained. A throwing move leaves that value where it was.
+  void MigrateStep() {
+    if (old_ctrl_ == nullptr) return;
+    size_type stop = std::min(migrated_ + kMigrateSlots, old_capacity_);
+    for (; migrated_ < stop; ++migrated_) {
+      if (old_ctrl_[migrated_] < 0) continue;
+      Value *from = old_slots_ + migrated_;
+      std::uint64_t hash = HashOf(KeyOf()(*from));
+      size_type index = FindFree(hash);
+      std::allocator_traits<allocator_type>::construct(
+          allocator_, slots_ + index, std::move_if_noexcept(*from));
+      std::allocator_traits<allocator_type>::destroy(allocator_, from);
+      SetCtrl(old_ctrl_, old_capacity_, migrated_, HashGroup::kDeleted);
+      if (ctrl_[index] == HashGroup::kEmpty) --growth_left_;
+      SetCtrl(index, H2(hash));
+    }
+    if (migrated_ == old_capacity_) FreeOld();
+  }
+
+  void FinishMigration() {
+    while (old_ctrl_ != nullptr) MigrateStep();
+  }
+
+  //  Caller has destroyed or moved every old value
+  void FreeOld() {
+    if (old_ctrl_ == nullptr) return;
+    Deallocate(old_ctrl_, old_slots_, old_capacity_);
+    old_ctrl_ = nullptr;
+    old_slots_ = nullptr;
+    old_capacity_ = migrated_ = 0;
+  }
+
+  void CopyFrom(const HashTable &other) {
+    if (other.size_ == 0) return;
+    Rehash(CapacityFor(other.size_));
+    for (const Value &value : other) {
+      std::uint64_t hash = HashOf(KeyOf()(value));
+      size_type index = FindFree(hash);
+      std::allocator_traits<allocator_type>::construct(allocator_,
+                                                       slots_ + index, value);
+      SetCtrl(index, H2(hash));
+      ++size_;
+      --growth_left_;
+    }
+  }
+
+  void DestroySlots() {
+    for (size_type i = 0; i < capacity_ && size_ != 0; ++i) {
+      if (ctrl_[i] >= 0) {
+        std::allocator_traits<allocator_type>::destroy(allocator_,
+                                                       slots_ + i);
+      }
+    }
+    for (size_type i = migrated_; i < old_capacity_; ++i) {
+      if (old_ctrl_[i] >= 0) {
+        std::allocator_traits<allocator_type>::destroy(allocator_,
+                                                       old_slots_ + i);
+      }
+    }
+  }
+
+  void Destroy() {
+    if (capacity_ == 0) return;
+    DestroySlots();
+    FreeOld();
+    Deallocate(ctrl_, slots_, capacity_);
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = size_ = growth_left_ = 0;
+  }
+};  // class HashTable
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_HASH_TABLE_H_
@@ -0,0 +1,147 @@
+#ifndef CONTAINERS_SRC_S21_INTERVAL_MAP_H_
+#define CONTAINERS_SRC_S21_INTERVAL_MAP_H_
+
+#include <functional>
+#include <stdexcept>
+
+#include "s21_binary_tree.h"
+#include "s21_map.h"
+
+namespace s21 {
+//  One stored range, [start, end) where start is the tree key
+template <class K, class V>
+struct IntervalSegment {
+  K end;
+  V value;
+};
+
+//  Maps half-open key ranges to values. Segments never overlap and
+//  touching segments with equal values are always merged, so the tree
+//  holds the minimal number of ranges. The tree is a treap, so it stays
+//  O(log n) deep whatever order ranges arrive in. The
+//  tree is a private base: its own inserts would skip the cutting and
+//  merging, so only the read side is exposed.
+template <class K, class V, class Compare = std::less<K>>
+class interval_map
+    : BinaryTree<std::pair<const K, IntervalSegment<K, V>>,
+                 MyComparator<K, IntervalSegment<K, V>, Compare>> {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using segment_type = IntervalSegment<K, V>;
+  using value_type = std::pair<const K, segment_type>;
+  using BTree =
+      BinaryTree<value_type, MyComparator<K, segment_type, Compare>>;
+  using iterator = typename BTree::iterator;
+  using const_iterator = typename BTree::const_iterator;
+  using size_type = typename BTree::size_type;
+
+  using BTree::begin;
+  using BTree::empty;
+  using BTree::end;
+  using BTree::height;
+  using BTree::size;
+
+  interval_map() {}
+
+  //  Maps every key of [lo, hi) to value, splitting the ranges it cuts
+  template <class T>
+  void assign(const K &lo, const K &hi, T &&value) {
+    if (!KeyLess(lo, hi)) return;
+    Cut(lo, hi);
+    Node *prev = Floor(lo);
+    Node *next = (prev != nullptr) ? BTree::Next(prev) : BTree::leftmost_;
+    bool join_prev = prev != nullptr && !KeyLess(prev->key.second.end, lo) &&
+                     prev->key.second.value == value;
+    bool join_next = next != nullptr && !KeyLess(hi, next->key.first) &&
+                     next->key.second.value == value;
+    if (join_prev) {
+      prev->key.second.end = join_next ? next->key.second.end : hi;
+      if (join_next) BTree::erase(iterator(next));
+    } else if (join_next) {
+      //  The start is the node's key, so the wider range replaces it
+      segment_type segment{next->key.second.end, std::forward<T>(value)};
+      BTree::erase(iterator(next));
+      Insert(lo, std::move(segment));
+    } else {
+      Insert(lo, segment_type{hi, std::forward<T>(value)});
+    }
+  }
+
+  using BTree::clear;
+
+  //  Unmaps [lo, hi)
+  void erase(const K &lo, const K &hi) {
+    if (KeyLess(lo, hi)) Cut(lo, hi);
+  }
+
+  //  The value covering key, or nullptr; O(log n)
+  const V *find(const K &key) const {
+    Node *node = Floor(key);
+    if (node == nullptr || !KeyLess(key, node->key.second.end)) {
+      return nullptr;
+    }
+    return &node->key.second.value;
+  }
+
+  bool contains(const K &key) const { return find(key) != nullptr; }
+
+  const V &at(const K &key) const {
+    const V *value = find(key);
+    if (value == nullptr) {
+      throw std::out_of_range("Fail");
+    }
+    return *value;
+  }
+
+ private:
+  using Node = typename BTree::Node;
+
+  static bool KeyLess(const K &a, const K &b, Compare cmp = Compare{}) {
+    return cmp(a, b);
+  }
+
+  //  Segment with the greatest start not after key
+  Node *Floor(const K &key) const {
+    Node *node = BTree::root_;
+    Node *best = nullptr;
+    while (node != nullptr) {
+      //  key < node->key
+      if (KeyLess(key, node->key.first)) {
+        node = node->left;
+      } else {
+        best = node;
+        node = node->right;
+      }
+    }
+    return best;
+  }
+
+  //  Clears [lo, hi), trimming or splitting the segments sticking out
+  void Cut(const K &lo, const K &hi) {
+    Node *node = Floor(lo);
+    if (node == nullptr) node = BTree::leftmost_;
+    while (node != nullptr && KeyLess(node->key.first, hi)) {
+      Node *next = BTree::Next(node);
+      segment_type &segment = node->key.second;
+      if (KeyLess(lo, segment.end)) {
+        if (KeyLess(hi, segment.end)) {
+          Insert(hi, segment_type{segment.end, segment.value});
+        }
+        if (KeyLess(node->key.first, lo)) {
+          segment.end = lo;
+        } else {
+          BTree::erase(iterator(node));
+        }
+      }
+      node = next;
+    }
+  }
+
+  void Insert(const K &start, segment_type &&segment) {
+    BTree::InsertIt(value_type(start, std::move(segment)));
+  }
+};  // class interval_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_INTERVAL_MAP_H_
@@ -1,8 +1,10 @@
 #ifndef CONTAINERS_SRC_S21_MAP_H_
 #define CONTAINERS_SRC_S21_MAP_H_
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <type_traits>
 
 #include "s21_binary_tree.h"
 
@@ -36,6 +38,15 @@ class map : public BinaryTree<std::pair<const Key, T>,
   using BTree = typename s21::BinaryTree<value_type, Comp, Allocator>;
   using node_pointer_type =
       typename s21::BinaryTree<value_type, Comp, Allocator>::Node *;
+  //  One step of a batch for apply_batch()
+  enum class batch_kind { upsert, erase };
+  struct batch_op {
+    batch_kind kind{};
+    key_type key{};
+    mapped_type value{};
+  };
+  enum class batch_result { inserted, assigned, erased, not_found };
+
   map() {}
   map(std::initializer_list<value_type> const &items) {
     try {
@@ -58,18 +69,26 @@ class map : public BinaryTree<std::pair<const Key, T>,
     }
     return search->key.second;
   }
+  const mapped_type &at(const key_type &key) const {
+    node_pointer_type search = SearchMap(key);
+    if (search == nullptr) {
+      throw std::out_of_range("Fail");
+    }
+    return search->key.second;
+  }
 
   mapped_type &operator[](const Key &key) {
     node_pointer_type search = SearchMap(key);
-    node_pointer_type ins{};
     if (search == nullptr) {
-      mapped_type val{};
-      BTree::root_ =
-          BTree::InsertIt(BTree::root_, std::make_pair(key, val), &ins);
-      if (ins == nullptr) {
-        throw std::out_of_range("out_of_range");
-      }
-      return ins->key.second;
+      return BTree::emplace(key, mapped_type{}).first->second;
+    }
+    return search->key.second;
+  }
+
+  mapped_type &operator[](Key &&key) {
+    node_pointer_type search = SearchMap(key);
+    if (search == nullptr) {
+      return BTree::emplace(std::move(key), mapped_type{}).first->second;
     }
     return search->key.second;
   }
@@ -84,47 +103,165 @@ class map : public BinaryTree<std::pair<const Key, T>,
   }
 
   map &operator=(map &&s) noexcept {
-    if (this != &s) {
-      this->root_ = s.root_;
-      s.root_ = nullptr;
-      this->size_ = s.size_;
-      this->allocator_ = s.allocator_;
-    }
+    BTree::operator=(std::move(s));
     return *this;
   }
 
-  bool contains(const Key &key) { return (SearchMap(key) != nullptr); }
+  bool contains(const Key &key) const { return (SearchMap(key) != nullptr); }
+
+  iterator find(const Key &key) { return iterator(SearchMap(key)); }
+  const_iterator find(const Key &key) const {
+    return const_iterator(SearchMap(key));
+  }
+
+  using BTree::erase;
+  //  Returns the number of removed entries, 0 or 1
+  size_type erase(const Key &key) {
+    node_pointer_type search = SearchMap(key);
+    if (search == nullptr) return 0;
+    BTree::erase(iterator(search));
+    return 1;
+  }
 
-  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+  template <class K, class V>
+  std::pair<iterator, bool> insert_or_assign(K &&key, V &&obj) {
     node_pointer_type search = SearchMap(key);
-    if (search == nullptr) return BTree::insert(std::make_pair(key, obj));
-    search->key.second = obj;
+    if (search == nullptr) {
+      return BTree::emplace(std::forward<K>(key), std::forward<V>(obj));
+    }
+    search->key.second = std::forward<V>(obj);
     iterator it(search);
     return std::make_pair(it, false);
   }
 
-  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
-    return BTree::insert(std::make_pair(key, obj));
+  //  The pair is built once, directly inside the new node
+  template <class K, class V,
+            std::enable_if_t<!std::is_convertible_v<K, const_iterator>,
+                             int> = 0>
+  std::pair<iterator, bool> insert(K &&key, V &&obj) {
+    if (SearchMap(key) != nullptr) {
+      return std::make_pair(this->end(), false);
+    }
+    return BTree::emplace(std::forward<K>(key), std::forward<V>(obj));
   }
 
   std::pair<iterator, bool> insert(const value_type &value) {
     return BTree::insert(value);
   }
 
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return BTree::insert(std::move(value));
+  }
+
+  iterator insert(const_iterator hint, const value_type &value) {
+    return BTree::insert(hint, value);
+  }
+
+  iterator insert(const_iterator hint, value_type &&value) {
+    return BTree::insert(hint, std::move(value));
+  }
+
+  //  Applies ops sorted by key in one traversal, ops on equal keys take
+  //  effect in order. results[i] receives the outcome of first[i]. Keys and
+  //  values of new entries are moved out of the ops. The traversal follows
+  //  the search paths, which the treap keeps O(log n) deep.
+  void apply_batch(batch_op *first, batch_op *last, batch_result *results) {
+    try {
+      BTree::root_ = ApplyBatch(BTree::root_, first, last, first, results);
+    } catch (...) {
+      BTree::ResetBounds();
+      throw;
+    }
+    BTree::ResetBounds();
+  }
+
  private:
-  bool LessMap(Key a, Key b, Compare cmp = Compare{}) { return cmp(a, b); }
-  node_pointer_type SearchMap(const key_type &key) {
-    return SearchMap(BTree::root_, key);
-  }
-
-  node_pointer_type SearchMap(node_pointer_type node, const key_type &key) {
-    if (node == nullptr) return nullptr;
-    //  node->key == key
-    if (!LessMap(key, (node->key).first) && !LessMap((node->key).first, key))
-      return node;
-    //  key < node->key
-    return (LessMap(key, (node->key).first) ? SearchMap(node->left, key)
-                                            : SearchMap(node->right, key));
+  static bool LessMap(const Key &a, const Key &b, Compare cmp = Compare{}) {
+    S21_TREE_COUNT(comparisons);
+    return cmp(a, b);
+  }
+  //  Returns the new root of the subtree after applying [first, last)
+  node_pointer_type ApplyBatch(node_pointer_type node, batch_op *first,
+                               batch_op *last, batch_op *base,
+                               batch_result *results) {
+    if (first == last) return node;
+    if (node == nullptr) return BuildRun(first, last, base, results);
+    const key_type &key = node->key.first;
+    batch_op *lower = std::partition_point(
+        first, last, [&](const batch_op &op) { return LessMap(op.key, key); });
+    batch_op *upper =
+        std::partition_point(lower, last, [&](const batch_op &op) {
+          return !LessMap(key, op.key);
+        });
+    node->left = ApplyBatch(node->left, first, lower, base, results);
+    BTree::SetParent(node->left, node);
+    node->right = ApplyBatch(node->right, upper, last, base, results);
+    BTree::SetParent(node->right, node);
+    bool alive = true;
+    for (batch_op *op = lower; op != upper; ++op) {
+      results[op - base] = ApplyOp(op, &alive);
+      if (op->kind == batch_kind::upsert) {
+        node->key.second = std::move(op->value);
+      }
+    }
+    //  New runs below may outrank the node, joining restores heap order
+    if (alive) return BTree::JoinAround(node->left, node, node->right);
+    node_pointer_type rest = BTree::JoinNodes(node->left, node->right);
+    BTree::DealocNode(node);
+    return rest;
+  }
+
+  //  Ops that all land in one empty subtree become a treap of their own
+  node_pointer_type BuildRun(batch_op *first, batch_op *last, batch_op *base,
+                             batch_result *results) {
+    s21::vector<node_pointer_type> nodes(last - first);
+    size_type count = 0;
+    try {
+      for (batch_op *group = first; group != last;) {
+        bool alive = false;
+        batch_op *value = nullptr;
+        batch_op *op = group;
+        for (; op != last && !LessMap(group->key, op->key); ++op) {
+          results[op - base] = ApplyOp(op, &alive);
+          if (op->kind == batch_kind::upsert) value = op;
+        }
+        if (alive) {
+          nodes[count] =
+              BTree::NewNode(std::move(value->key), std::move(value->value));
+          ++count;
+        }
+        group = op;
+      }
+      return BTree::BuildTreap(nodes.data(), nodes.data() + count);
+    } catch (...) {
+      for (size_type i = 0; i < count; ++i) BTree::DealocNode(nodes[i]);
+      throw;
+    }
+  }
+
+  static batch_result ApplyOp(const batch_op *op, bool *alive) {
+    bool was_alive = *alive;
+    *alive = (op->kind == batch_kind::upsert);
+    if (*alive) {
+      return was_alive ? batch_result::assigned : batch_result::inserted;
+    }
+    return was_alive ? batch_result::erased : batch_result::not_found;
+  }
+
+  node_pointer_type SearchMap(const key_type &key) const {
+    node_pointer_type node = BTree::root_;
+    while (node != nullptr) {
+      //  key < node->key
+      if (LessMap(key, (node->key).first)) {
+        node = node->left;
+        //  node->key < key
+      } else if (LessMap((node->key).first, key)) {
+        node = node->right;
+      } else {
+        return node;
+      }
+    }
+    return nullptr;
   }
 };
 }  // namespace s21
@@ -0,0 +1,357 @@
+#ifndef CONTAINERS_SRC_S21_MULTI_INDEX_H_
+#define CONTAINERS_SRC_S21_MULTI_INDEX_H_
+
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "s21_binary_tree.h"
+
+namespace s21 {
+//  Key extractor reading a data member, e.g. member<Task, int, &Task::id>
+template <class T, class Member, Member T::*Field>
+struct member {
+  const Member &operator()(const T &value) const { return value.*Field; }
+};
+
+template <class KeyFn, class Compare = std::less<>>
+struct ordered_unique {
+  using key_fn = KeyFn;
+  using compare = Compare;
+  static constexpr bool unique = true;
+};
+
+//  Equal keys are kept in address order, so any element is found in O(h)
+template <class KeyFn, class Compare = std::less<>>
+struct ordered_non_unique {
+  using key_fn = KeyFn;
+  using compare = Compare;
+  static constexpr bool unique = false;
+};
+
+template <class T, class Index>
+class MultiIndexOrder {
+ public:
+  bool operator()(const T *a, const T *b) const {
+    typename Index::key_fn key;
+    typename Index::compare less;
+    if (less(key(*a), key(*b))) return true;
+    if (Index::unique || less(key(*b), key(*a))) return false;
+    return std::less<const T *>{}(a, b);
+  }
+};
+
+//  One ordered view over the elements of a multi_index, its nodes hold
+//  only a pointer to the shared element
+template <class T, class Index>
+class MultiIndexView : BinaryTree<const T *, MultiIndexOrder<T, Index>> {
+  template <class, class...>
+  friend class multi_index;
+  using BTree = BinaryTree<const T *, MultiIndexOrder<T, Index>>;
+  using Node = typename BTree::Node;
+
+ public:
+  class ViewIterator;
+  using iterator = ViewIterator;
+  using const_iterator = ViewIterator;
+  using size_type = typename BTree::size_type;
+  using key_fn = typename Index::key_fn;
+  using key_compare = typename Index::compare;
+  using key_type =
+      std::decay_t<decltype(key_fn{}(std::declval<const T &>()))>;
+
+  class ViewIterator {
+   public:
+    using value_type = T;
+    using pointer = const T *;
+    using reference = const T &;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+    ViewIterator(typename BTree::const_iterator it) : it_(it) {}
+    reference operator*() const { return **it_; }
+    pointer operator->() const { return *it_; }
+    bool operator==(const ViewIterator &other) const {
+      return it_ == other.it_;
+    }
+    bool operator!=(const ViewIterator &other) const {
+      return it_ != other.it_;
+    }
+    ViewIterator &operator++() {
+      ++it_;
+      return *this;
+    }
+    ViewIterator operator++(int) {
+      ViewIterator temp = *this;
+      ++it_;
+      return temp;
+    }
+
+   private:
+    typename BTree::const_iterator it_;
+  };  //  class ViewIterator
+
+  const_iterator begin() const { return ViewIterator(BTree::begin()); }
+  const_iterator end() const { return ViewIterator(BTree::end()); }
+  size_type size() const { return BTree::size_; }
+  bool empty() const { return BTree::size_ == 0; }
+
+  //  First element whose key is not less than `key`
+  const_iterator lower_bound(const key_type &key) const {
+    Node *node = BTree::root_;
+    Node *bound = nullptr;
+    while (node != nullptr) {
+      //  node->key < key
+      if (key_compare{}(key_fn{}(*node->key), key)) {
+        node = node->right;
+      } else {
+        bound = node;
+        node = node->left;
+      }
+    }
+    return Wrap(bound);
+  }
+
+  //  First element whose key is greater than `key`
+  const_iterator upper_bound(const key_type &key) const {
+    Node *node = BTree::root_;
+    Node *bound = nullptr;
+    while (node != nullptr) {
+      //  key < node->key
+      if (key_compare{}(key, key_fn{}(*node->key))) {
+        bound = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return Wrap(bound);
+  }
+
+  const_iterator find(const key_type &key) const {
+    const_iterator it = lower_bound(key);
+    return (it == end() || key_compare{}(key, key_fn{}(*it))) ? end() : it;
+  }
+
+  bool contains(const key_type &key) const { return find(key) != end(); }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  size_type count(const key_type &key) const {
+    size_type result = 0;
+    const_iterator last = upper_bound(key);
+    for (const_iterator it = lower_bound(key); it != last; ++it) ++result;
+    return result;
+  }
+
+ private:
+  static const_iterator Wrap(Node *node) {
+    return ViewIterator(typename BTree::const_iterator(node));
+  }
+
+  //  Another element that would collide with `candidate` in a unique index
+  const T *Clash(const T *candidate, const T *self) {
+    if (!Index::unique) return nullptr;
+    Node *node = BTree::Search(candidate);
+    return (node != nullptr && node->key != self) ? node->key : nullptr;
+  }
+
+  void Link(const T *element) { BTree::insert(element); }
+
+  void Remove(const T *element) {
+    BTree::erase(typename BTree::iterator(BTree::Search(element)));
+  }
+
+  //  Unhooks the element's node without freeing it
+  Node *Detach(const T *element) {
+    Node *node = BTree::Search(element);
+    BTree::Unlink(node);
+    return node;
+  }
+
+  void Reattach(Node *node) { BTree::InsertNode(node); }
+
+  void Drop(Node *node) { BTree::DealocNode(node); }
+};  // class MultiIndexView
+
+//  Stores every element once and keeps one ordered view per index in
+//  step: an insert, erase or replace either updates all views or none.
+//  Each view costs a single pointer-sized tree node per element.
+template <class T, class... Indexes>
+class multi_index {
+  static_assert(sizeof...(Indexes) > 0, "multi_index needs an index");
+  using Sequence = std::index_sequence_for<Indexes...>;
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  template <std::size_t I>
+  using view_type =
+      MultiIndexView<T, std::tuple_element_t<I, std::tuple<Indexes...>>>;
+
+  multi_index() {}
+  multi_index(std::initializer_list<T> const &items) {
+    try {
+      for (auto it = items.begin(); it != items.end(); ++it) insert(*it);
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+  multi_index(const multi_index &) = delete;
+  multi_index &operator=(const multi_index &) = delete;
+  multi_index(multi_index &&other) noexcept
+      : indexes_(std::move(other.indexes_)) {}
+  multi_index &operator=(multi_index &&other) noexcept {
+    if (this != &other) {
+      clear();
+      indexes_ = std::move(other.indexes_);
+    }
+    return *this;
+  }
+  ~multi_index() { clear(); }
+
+  template <std::size_t I>
+  const view_type<I> &get() const {
+    return std::get<I>(indexes_);
+  }
+
+  size_type size() const { return std::get<0>(indexes_).size(); }
+  bool empty() const { return size() == 0; }
+
+  //  Returns the clashing element and false if a unique index rejects it
+  std::pair<const T *, bool> insert(const T &value) { return emplace(value); }
+  std::pair<const T *, bool> insert(T &&value) {
+    return emplace(std::move(value));
+  }
+
+  template <class... Args>
+  std::pair<const T *, bool> emplace(Args &&...args) {
+    T *element = NewElement(std::forward<Args>(args)...);
+    const T *clash = FindClash(element, nullptr, Sequence{});
+    if (clash != nullptr) {
+      DeleteElement(element);
+      return std::make_pair(clash, false);
+    }
+    try {
+      Link(element, Sequence{});
+    } catch (...) {
+      DeleteElement(element);
+      throw;
+    }
+    return std::make_pair(element, true);
+  }
+
+  void erase(const T *element) {
+    Remove(element, Sequence{});
+    DeleteElement(const_cast<T *>(element));
+  }
+
+  //  Swaps in a new value and re-sorts the element in every index without
+  //  allocating. False, with nothing changed, if a unique index clashes.
+  //  If T's move assignment throws the element is erased.
+  bool replace(const T *element, T value) {
+    if (FindClash(&value, element, Sequence{}) != nullptr) {
+      return false;
+    }
+    std::tuple<typename MultiIndexView<T, Indexes>::Node *...> nodes;
+    Detach(element, nodes, Sequence{});
+    try {
+      *const_cast<T *>(element) = std::move(value);
+    } catch (...) {
+      Drop(nodes, Sequence{});
+      DeleteElement(const_cast<T *>(element));
+      throw;
+    }
+    Reattach(nodes, Sequence{});
+    return true;
+  }
+
+  //  Runs fn(T &) on a copy and replaces the element with it
+  template <class Fn>
+  bool modify(const T *element, Fn fn) {
+    T copy(*element);
+    fn(copy);
+    return replace(element, std::move(copy));
+  }
+
+  void clear() {
+    const view_type<0> &primary = std::get<0>(indexes_);
+    for (auto it = primary.begin(); it != primary.end(); ++it) {
+      DeleteElement(const_cast<T *>(&*it));
+    }
+    std::apply([](auto &...index) { (index.clear(), ...); }, indexes_);
+  }
+
+ private:
+  std::tuple<MultiIndexView<T, Indexes>...> indexes_;
+  std::allocator<T> allocator_;
+
+  template <class... Args>
+  T *NewElement(Args &&...args) {
+    T *element = std::allocator_traits<std::allocator<T>>::allocate(allocator_, 1);
+    try {
+      std::allocator_traits<std::allocator<T>>::construct(
+          allocator_, element, std::forward<Args>(args)...);
+    } catch (...) {
+      std::allocator_traits<std::allocator<T>>::deallocate(allocator_, element,
+                                                           1);
+      throw;
+    }
+    return element;
+  }
+
+  void DeleteElement(T *element) {
+    std::allocator_traits<std::allocator<T>>::destroy(allocator_, element);
+    std::allocator_traits<std::allocator<T>>::deallocate(allocator_, element,
+                                                         1);
+  }
+
+  template <std::size_t... I>
+  const T *FindClash(const T *candidate, const T *self,
+                     std::index_sequence<I...>) {
+    const T *clash = nullptr;
+    ((clash = clash ? clash : std::get<I>(indexes_).Clash(candidate, self)),
+     ...);
+    return clash;
+  }
+
+  //  All or nothing, a failed node allocation unlinks the earlier views
+  template <std::size_t... I>
+  void Link(const T *element, std::index_sequence<I...>) {
+    std::size_t linked = 0;
+    try {
+      ((std::get<I>(indexes_).Link(element), ++linked), ...);
+    } catch (...) {
+      ((I < linked ? std::get<I>(indexes_).Remove(element) : void()), ...);
+      throw;
+    }
+  }
+
+  template <std::size_t... I>
+  void Remove(const T *element, std::index_sequence<I...>) {
+    (std::get<I>(indexes_).Remove(element), ...);
+  }
+
+  template <class Nodes, std::size_t... I>
+  void Detach(const T *element, Nodes &nodes, std::index_sequence<I...>) {
+    ((std::get<I>(nodes) = std::get<I>(indexes_).Detach(element)), ...);
+  }
+
+  template <class Nodes, std::size_t... I>
+  void Reattach(Nodes &nodes, std::index_sequence<I...>) {
+    (std::get<I>(indexes_).Reattach(std::get<I>(nodes)), ...);
+  }
+
+  template <class Nodes, std::size_t... I>
+  void Drop(Nodes &nodes, std::index_sequence<I...>) {
+    (std::get<I>(indexes_).Drop(std::get<I>(nodes)), ...);
+  }
+};  // class multi_index
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_MULTI_INDEX_H_
@@ -0,0 +1,401 @@
+#ifndef CONTAINERS_SRC_S21_MULTIMAP_H_
+#define CONTAINERS_SRC_S21_MULTIMAP_H_
+
+#include <functional>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "s21_binary_tree.h"
+#include "s21_map.h"
+
+namespace s21 {
+//  Equal keys are kept in insertion order, one node per value
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class multimap : public BinaryTree<std::pair<const Key, T>,
+                                   MyComparator<Key, T, Compare>, Allocator,
+                                   true> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using BTree = BinaryTree<value_type, MyComparator<Key, T, Compare>,
+                           Allocator, true>;
+  using iterator = typename BTree::iterator;
+  using const_iterator = typename BTree::const_iterator;
+  using size_type = typename BTree::size_type;
+
+  multimap() {}
+  multimap(std::initializer_list<value_type> const &items) : BTree(items) {}
+  multimap(const multimap &other) : BTree(other) {}
+  multimap(multimap &&other) noexcept : BTree(std::move(other)) {}
+  multimap &operator=(const multimap &other) {
+    BTree::operator=(other);
+    return *this;
+  }
+  multimap &operator=(multimap &&other) noexcept {
+    BTree::operator=(std::move(other));
+    return *this;
+  }
+
+  //  Always succeeds, after any values already under the key; O(h)
+  iterator insert(const value_type &value) {
+    return BTree::insert(value).first;
+  }
+  iterator insert(value_type &&value) {
+    return BTree::insert(std::move(value)).first;
+  }
+  template <class K, class V,
+            std::enable_if_t<!std::is_convertible_v<K, const_iterator>,
+                             int> = 0>
+  iterator insert(K &&key, V &&obj) {
+    return BTree::emplace(std::forward<K>(key), std::forward<V>(obj)).first;
+  }
+  iterator insert(const_iterator hint, const value_type &value) {
+    return BTree::insert(hint, value);
+  }
+  iterator insert(const_iterator hint, value_type &&value) {
+    return BTree::insert(hint, std::move(value));
+  }
+  template <class... Args>
+  iterator emplace(Args &&...args) {
+    return BTree::emplace(std::forward<Args>(args)...).first;
+  }
+
+  //  First value under the key
+  iterator find(const Key &key) {
+    Node *node = LowerBound(key);
+    return iterator(
+        (node == nullptr || KeyLess(key, node->key.first)) ? nullptr : node);
+  }
+  bool contains(const Key &key) { return find(key) != this->end(); }
+
+  iterator lower_bound(const Key &key) { return iterator(LowerBound(key)); }
+  iterator upper_bound(const Key &key) { return iterator(UpperBound(key)); }
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  //  O(h + count)
+  size_type count(const Key &key) {
+    size_type result = 0;
+    Node *last = UpperBound(key);
+    for (Node *node = LowerBound(key); node != last;
+         node = BTree::Next(node)) {
+      ++result;
+    }
+    return result;
+  }
+
+  using BTree::erase;
+  //  Removes every value under the key and returns how many there were
+  size_type erase(const Key &key) {
+    size_type result = 0;
+    Node *last = UpperBound(key);
+    for (Node *node = LowerBound(key); node != last; ++result) {
+      Node *next = BTree::Next(node);
+      BTree::erase(iterator(node));
+      node = next;
+    }
+    return result;
+  }
+
+ private:
+  using Node = typename BTree::Node;
+
+  static bool KeyLess(const Key &a, const Key &b, Compare cmp = Compare{}) {
+    return cmp(a, b);
+  }
+
+  Node *LowerBound(const Key &key) const {
+    Node *node = BTree::root_;
+    Node *bound = nullptr;
+    while (node != nullptr) {
+      //  node->key < key
+      if (KeyLess(node->key.first, key)) {
+        node = node->right;
+      } else {
+        bound = node;
+        node = node->left;
+      }
+    }
+    return bound;
+  }
+
+  Node *UpperBound(const Key &key) const {
+    Node *node = BTree::root_;
+    Node *bound = nullptr;
+    while (node != nullptr) {
+      //  key < node->key
+      if (KeyLess(key, node->key.first)) {
+        bound = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return bound;
+  }
+};  // class multimap
+
+//  The values of one run_multimap key, contiguous and in insertion order.
+//  Runs of up to Inline values live inside the tree node itself.
+template <class T, std::size_t Inline>
+class ValueRun {
+  static_assert(Inline > 0, "a run keeps at least one value inline");
+
+ public:
+  using size_type = std::size_t;
+
+  ValueRun() {}
+  ValueRun(const ValueRun &other) {
+    try {
+      Reserve(other.size_);
+      for (; size_ < other.size_; ++size_) {
+        ::new (data_ + size_) T(other.data_[size_]);
+      }
+    } catch (...) {
+      Destroy();
+      throw;
+    }
+  }
+  ValueRun &operator=(const ValueRun &) = delete;
+  ~ValueRun() { Destroy(); }
+
+  T *begin() { return data_; }
+  T *end() { return data_ + size_; }
+  const T *begin() const { return data_; }
+  const T *end() const { return data_ + size_; }
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  T &operator[](size_type i) { return data_[i]; }
+  const T &operator[](size_type i) const { return data_[i]; }
+
+  template <class... Args>
+  T &emplace_back(Args &&...args) {
+    auto build = [&](T *slot) {
+      ::new (slot) T(std::forward<Args>(args)...);
+      return true;
+    };
+    if (size_ == capacity_) {
+      Grow(2 * capacity_, build);
+    } else {
+      build(data_ + size_);
+    }
+    return data_[size_++];
+  }
+
+  //  Keeps the order of the remaining values
+  void erase(T *pos) {
+    for (T *it = pos; it + 1 != end(); ++it) *it = std::move(*(it + 1));
+    data_[--size_].~T();
+  }
+
+ private:
+  T *data_ = Local();
+  size_type size_{};
+  size_type capacity_ = Inline;
+  alignas(T) unsigned char local_[Inline * sizeof(T)];
+
+  T *Local() { return reinterpret_cast<T *>(local_); }
+
+  void Destroy() {
+    for (size_type i = 0; i < size_; ++i) data_[i].~T();
+    if (data_ != Local()) std::allocator<T>().deallocate(data_, capacity_);
+  }
+
+  void Reserve(size_type count) {
+    if (count <= capacity_) return;
+    Grow(count, [](T *) { return false; });
+  }
+
+  //  Moves the run to `count` > capacity_ slots. build(slot) may construct
+  //  the value after the last one and returns whether it did; it runs
+  //  before the old values move, so its arguments may refer to them.
+  template <class Build>
+  void Grow(size_type count, Build build) {
+    T *data = std::allocator<T>().allocate(count);
+    bool built;
+    try {
+      built = build(data + size_);
+    } catch (...) {
+      std::allocator<T>().deallocate(data, count);
+      throw;
+    }
+    size_type moved = 0;
+    try {
+      for (; moved < size_; ++moved) {
+        ::new (data + moved) T(std::move_if_noexcept(data_[moved]));
+      }
+    } catch (...) {
+      for (size_type i = 0; i < moved; ++i) data[i].~T();
+      if (built) data[size_].~T();
+      std::allocator<T>().deallocate(data, count);
+      throw;
+    }
+    for (size_type i = 0; i < size_; ++i) data_[i].~T();
+    if (data_ != Local()) std::allocator<T>().deallocate(data_, capacity_);
+    data_ = data;
+    capacity_ = count;
+  }
+};  // class ValueRun
+
+//  Multimap with one tree node per distinct key whose values form a
+//  contiguous ValueRun, so scanning one key's values is sequential and
+//  count() is O(h). Iteration visits keys in order; it->second is the run.
+//  Pointers into a run are invalidated when the run grows.
+template <class Key, class T, class Compare = std::less<Key>,
+          std::size_t Inline = (sizeof(T) <= 16 ? 32 / sizeof(T) : 1)>
+class run_multimap
+    : BinaryTree<std::pair<const Key, ValueRun<T, Inline>>,
+                 MyComparator<Key, ValueRun<T, Inline>, Compare>> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using run_type = ValueRun<T, Inline>;
+  using value_type = std::pair<const Key, run_type>;
+  using BTree = BinaryTree<value_type, MyComparator<Key, run_type, Compare>>;
+  using iterator = typename BTree::iterator;
+  using const_iterator = typename BTree::const_iterator;
+  using size_type = typename BTree::size_type;
+
+  run_multimap() {}
+  run_multimap(std::initializer_list<std::pair<const Key, T>> const &items) {
+    for (auto it = items.begin(); it != items.end(); ++it) {
+      insert(it->first, it->second);
+    }
+  }
+  run_multimap(const run_multimap &other)
+      : BTree(other), size_(other.size_) {}
+  run_multimap(run_multimap &&other) noexcept
+      : BTree(std::move(other)), size_(other.size_) {
+    other.size_ = 0;
+  }
+  run_multimap &operator=(const run_multimap &other) {
+    if (this != &other) {
+      run_multimap copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+  run_multimap &operator=(run_multimap &&other) noexcept {
+    if (this != &other) {
+      BTree::operator=(std::move(other));
+      size_ = other.size_;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  using BTree::begin;
+  using BTree::end;
+  //  Number of values; key_count() gives the number of runs
+  size_type size() const { return size_; }
+  size_type key_count() const { return BTree::size_; }
+  bool empty() const { return size_ == 0; }
+
+  //  Appends to the key's run, O(h) plus amortized O(1) for the append
+  iterator insert(const Key &key, const T &obj) { return emplace(key, obj); }
+  iterator insert(const Key &key, T &&obj) {
+    return emplace(key, std::move(obj));
+  }
+  template <class... Args>
+  iterator emplace(const Key &key, Args &&...args) {
+    Node *parent = nullptr;
+    Node **link = &this->root_;
+    while (*link != nullptr) {
+      parent = *link;
+      if (Compare()(key, parent->key.first)) {
+        link = &parent->left;
+      } else if (Compare()(parent->key.first, key)) {
+        link = &parent->right;
+      } else {
+        parent->key.second.emplace_back(std::forward<Args>(args)...);
+        ++size_;
+        return iterator(parent);
+      }
+    }
+    Node *node = BTree::NewNode(std::piecewise_construct,
+                                std::forward_as_tuple(key), std::tuple<>());
+    try {
+      node->key.second.emplace_back(std::forward<Args>(args)...);
+    } catch (...) {
+      BTree::DealocNode(node);
+      throw;
+    }
+    BTree::Attach(node, parent, link);
+    ++size_;
+    return iterator(node);
+  }
+
+  iterator find(const Key &key) { return iterator(Find(key)); }
+  const_iterator find(const Key &key) const {
+    return const_iterator(Find(key));
+  }
+  bool contains(const Key &key) const { return Find(key) != nullptr; }
+
+  //  O(h), the run knows its length
+  size_type count(const Key &key) const {
+    Node *node = Find(key);
+    return node == nullptr ? 0 : node->key.second.size();
+  }
+
+  //  The key's values as one contiguous range, empty if it is missing
+  std::pair<T *, T *> equal_range(const Key &key) {
+    Node *node = Find(key);
+    if (node == nullptr) return std::pair<T *, T *>();
+    return std::make_pair(node->key.second.begin(), node->key.second.end());
+  }
+  std::pair<const T *, const T *> equal_range(const Key &key) const {
+    Node *node = Find(key);
+    if (node == nullptr) return std::pair<const T *, const T *>();
+    return std::make_pair(node->key.second.begin(), node->key.second.end());
+  }
+
+  //  Removes the whole run under the key, returning its length
+  size_type erase(const Key &key) {
+    Node *node = Find(key);
+    if (node == nullptr) return 0;
+    size_type removed = node->key.second.size();
+    BTree::erase(iterator(node));
+    size_ -= removed;
+    return removed;
+  }
+
+  //  Removes one value from a run, dropping the key with its last value
+  void erase(iterator pos, T *value) {
+    Node *node = BTree::NodeOf(pos);
+    node->key.second.erase(value);
+    --size_;
+    if (node->key.second.empty()) BTree::erase(iterator(node));
+  }
+
+  void clear() {
+    BTree::clear();
+    size_ = 0;
+  }
+
+ private:
+  using Node = typename BTree::Node;
+  size_type size_{};
+
+  Node *Find(const Key &key) const {
+    Node *node = BTree::root_;
+    while (node != nullptr) {
+      if (Compare()(key, node->key.first)) {
+        node = node->left;
+      } else if (Compare()(node->key.first, key)) {
+        node = node->right;
+      } else {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+};  // class run_multimap
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_MULTIMAP_H_
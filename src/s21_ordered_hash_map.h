@@ -0,0 +1,448 @@
+#ifndef CONTAINERS_SRC_S21_ORDERED_HASH_MAP_H_
+#define CONTAINERS_SRC_S21_ORDERED_HASH_MAP_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "s21_hash.h"
+
+namespace s21 {
+//  Hash map that iterates in insertion order, laid out like a Python dict.
+//  Entries are appended to one dense array; a separate power-of-two index
+//  of 32-bit entry positions is probed linearly to find them. Iteration is
+//  a scan of the entry array. Erase leaves a hole in the entries, closed
+//  up by the next resize, which also rebuilds the index. Re-inserting an
+//  existing key keeps its place.
+template <class Key, class T, class Hash = hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class ordered_hash_map {
+ public:
+  template <bool Const>
+  class OrderedIterator;
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using iterator = OrderedIterator<false>;
+  using const_iterator = OrderedIterator<true>;
+
+ private:
+  struct Entry {
+    template <class... Args>
+    Entry(std::uint64_t hash, Args &&...args)
+        : hash(hash), value(std::forward<Args>(args)...) {}
+    //  kDead once the value is destroyed
+    std::uint64_t hash;
+    value_type value;
+  };
+  static constexpr std::uint64_t kDead = ~std::uint64_t{};
+
+ public:
+  template <bool Const>
+  class OrderedIterator {
+    friend class ordered_hash_map;
+
+   public:
+    using value_type = ordered_hash_map::value_type;
+    using pointer = std::conditional_t<Const, const value_type *,
+                                       value_type *>;
+    using reference = std::conditional_t<Const, const value_type &,
+                                         value_type &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    OrderedIterator() {}
+    template <bool C = Const, class = std::enable_if_t<C>>
+    OrderedIterator(const OrderedIterator<false> &other)
+        : entry_(other.entry_), end_(other.end_) {}
+
+    reference operator*() const { return entry_->value; }
+    pointer operator->() const { return &entry_->value; }
+    bool operator==(const OrderedIterator &other) const {
+      return entry_ == other.entry_;
+    }
+    bool operator!=(const OrderedIterator &other) const {
+      return entry_ != other.entry_;
+    }
+    OrderedIterator &operator++() {
+      ++entry_;
+      SkipDead();
+      return *this;
+    }
+    OrderedIterator operator++(int) {
+      OrderedIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+   private:
+    OrderedIterator(Entry *entry, Entry *end) : entry_(entry), end_(end) {}
+    void SkipDead() {
+      while (entry_ != end_ && entry_->hash == kDead) ++entry_;
+    }
+    Entry *entry_{};
+    Entry *end_{};
+  };  //  class OrderedIterator
+
+  ordered_hash_map() {}
+  ordered_hash_map(std::initializer_list<value_type> const &items) {
+    try {
+      reserve(items.size());
+      for (auto it = items.begin(); it != items.end(); ++it) insert(*it);
+    } catch (...) {
+      DestroyEntries();
+      Deallocate(entries_, entry_capacity_, index_, index_capacity_);
+      throw;
+    }
+  }
+  ordered_hash_map(const ordered_hash_map &other)
+      : hash_(other.hash_), equal_(other.equal_), allocator_(other.allocator_) {
+    try {
+      reserve(other.size_);
+      for (const value_type &item : other) {
+        Append(Mix(hash_(item.first)), item);
+      }
+    } catch (...) {
+      DestroyEntries();
+      Deallocate(entries_, entry_capacity_, index_, index_capacity_);
+      throw;
+    }
+  }
+  ordered_hash_map(ordered_hash_map &&other) noexcept { swap(other); }
+  ordered_hash_map &operator=(const ordered_hash_map &other) {
+    if (this != &other) {
+      ordered_hash_map copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  ordered_hash_map &operator=(ordered_hash_map &&other) noexcept {
+    if (this != &other) {
+      ordered_hash_map empty;
+      swap(empty);
+      swap(other);
+    }
+    return *this;
+  }
+  ~ordered_hash_map() {
+    DestroyEntries();
+    Deallocate(entries_, entry_capacity_, index_, index_capacity_);
+  }
+
+  iterator begin() { return Begin<false>(); }
+  iterator end() { return iterator(entries_ + used_, entries_ + used_); }
+  const_iterator begin() const { return Begin<true>(); }
+  const_iterator end() const {
+    return const_iterator(entries_ + used_, entries_ + used_);
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type bucket_count() const { return index_capacity_; }
+
+  void clear() {
+    DestroyEntries();
+    std::fill(index_, index_ + index_capacity_, kFree);
+  }
+
+  //  Room for `count` entries without a resize
+  void reserve(size_type count) {
+    if (count > entry_capacity_) Resize(count);
+  }
+
+  iterator find(const Key &key) {
+    size_type slot = Find(key, Mix(hash_(key)));
+    return slot == kNotFound ? end() : At<false>(index_[slot]);
+  }
+  const_iterator find(const Key &key) const {
+    size_type slot = Find(key, Mix(hash_(key)));
+    return slot == kNotFound ? end() : At<true>(index_[slot]);
+  }
+  bool contains(const Key &key) const {
+    return Find(key, Mix(hash_(key))) != kNotFound;
+  }
+  size_type count(const Key &key) const { return contains(key); }
+
+  T &at(const Key &key) { return At(key); }
+  const T &at(const Key &key) const { return At(key); }
+
+  T &operator[](const Key &key) { return try_emplace(key).first->second; }
+  T &operator[](Key &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return TryEmplace(key, std::piecewise_construct,
+                      std::forward_as_tuple(key),
+                      std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return TryEmplace(key, std::piecewise_construct,
+                      std::forward_as_tuple(std::move(key)),
+                      std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return TryEmplace(value.first, value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return TryEmplace(value.first, std::move(value));
+  }
+  template <class K, class V,
+            std::enable_if_t<!std::is_convertible_v<K, const_iterator>,
+                             int> = 0>
+  std::pair<iterator, bool> insert(K &&key, V &&obj) {
+    const Key &probe = key;
+    return TryEmplace(probe, std::forward<K>(key), std::forward<V>(obj));
+  }
+
+  //  An existing key keeps its position and gets the new value
+  template <class V>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, V &&obj) {
+    auto result = try_emplace(key, std::forward<V>(obj));
+    if (!result.second) result.first->second = std::forward<V>(obj);
+    return result;
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return TryEmplace(value.first, std::move(value));
+  }
+
+  //  Returns the entry after pos in insertion order
+  iterator erase(const_iterator pos) {
+    const Key &key = pos->first;
+    Erase(Find(key, pos.entry_->hash));
+    iterator next(pos.entry_, entries_ + used_);
+    next.SkipDead();
+    return next;
+  }
+  size_type erase(const Key &key) {
+    size_type slot = Find(key, Mix(hash_(key)));
+    if (slot == kNotFound) return 0;
+    Erase(slot);
+    return 1;
+  }
+
+  void swap(ordered_hash_map &other) noexcept {
+    std::swap(entries_, other.entries_);
+    std::swap(entry_capacity_, other.entry_capacity_);
+    std::swap(used_, other.used_);
+    std::swap(size_, other.size_);
+    std::swap(index_, other.index_);
+    std::swap(index_capacity_, other.index_capacity_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+    std::swap(allocator_, other.allocator_);
+  }
+
+ private:
+  using EntryAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
+  using IndexAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<std::uint32_t>;
+  static constexpr std::uint32_t kFree = ~std::uint32_t{};
+  static constexpr std::uint32_t kErased = kFree - 1;
+  static constexpr size_type kNotFound = ~size_type{};
+
+  Entry *entries_{};
+  size_type entry_capacity_{};
+  //  Entries appended so far, holes included
+  size_type used_{};
+  size_type size_{};
+  //  Positions into entries_, kFree or kErased
+  std::uint32_t *index_{};
+  //  A power of two, at least 3/2 of entry_capacity_ so probes stay short
+  size_type index_capacity_{};
+  Hash hash_{};
+  KeyEqual equal_{};
+  EntryAllocator allocator_{};
+
+  //  Spreads the user hash, and keeps kDead out of the stored hashes
+  static std::uint64_t Mix(std::uint64_t hash) {
+    if constexpr (IsAvalanching<Hash>::value) return hash >> 1;
+    hash *= 0x9E3779B97F4A7C15ull;
+    return (hash ^ (hash >> 32)) >> 1;
+  }
+
+  T &At(const Key &key) const {
+    size_type slot = Find(key, Mix(hash_(key)));
+    if (slot == kNotFound) {
+      throw std::out_of_range("Fail");
+    }
+    return entries_[index_[slot]].value.second;
+  }
+
+  template <bool Const>
+  OrderedIterator<Const> At(size_type position) const {
+    return OrderedIterator<Const>(entries_ + position, entries_ + used_);
+  }
+
+  template <bool Const>
+  OrderedIterator<Const> Begin() const {
+    OrderedIterator<Const> it(entries_, entries_ + used_);
+    it.SkipDead();
+    return it;
+  }
+
+  //  Index slot pointing at the key, or kNotFound
+  size_type Find(const Key &key, std::uint64_t hash) const {
+    if (size_ == 0) return kNotFound;
+    size_type mask = index_capacity_ - 1;
+    for (size_type slot = hash & mask;; slot = (slot + 1) & mask) {
+      std::uint32_t position = index_[slot];
+      if (position == kFree) return kNotFound;
+      if (position != kErased && entries_[position].hash == hash &&
+          equal_(entries_[position].value.first, key)) {
+        return slot;
+      }
+    }
+  }
+
+  size_type FreeSlot(std::uint64_t hash) const {
+    size_type mask = index_capacity_ - 1;
+    size_type slot = hash & mask;
+    while (index_[slot] != kFree) slot = (slot + 1) & mask;
+    return slot;
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> TryEmplace(const Key &key, Args &&...args) {
+    std::uint64_t hash = Mix(hash_(key));
+    size_type slot = Find(key, hash);
+    if (slot != kNotFound) {
+      return std::make_pair(At<false>(index_[slot]), false);
+    }
+    auto build = [&](Entry *entry) {
+      std::allocator_traits<EntryAllocator>::construct(
+          allocator_, entry, hash, std::forward<Args>(args)...);
+      return true;
+    };
+    if (used_ == entry_capacity_) {
+      Resize(size_ + 1, build);
+    } else {
+      build(entries_ + used_);
+    }
+    index_[FreeSlot(hash)] = std::uint32_t(used_);
+    ++used_;
+    ++size_;
+    return std::make_pair(At<false>(used_ - 1), true);
+  }
+
+  //  Caller made sure used_ < entry_capacity_
+  template <class... Args>
+  void Append(std::uint64_t hash, Args &&...args) {
+    std::allocator_traits<EntryAllocator>::construct(
+        allocator_, entries_ + used_, hash, std::forward<Args>(args)...);
+    index_[FreeSlot(hash)] = std::uint32_t(used_);
+    ++used_;
+    ++size_;
+  }
+
+  void Erase(size_type slot) {
+    Entry &entry = entries_[index_[slot]];
+    std::allocator_traits<EntryAllocator>::destroy(allocator_, &entry);
+    entry.hash = kDead;
+    index_[slot] = kErased;
+    --size_;
+  }
+
+  void Resize(size_type count) {
+    Resize(count, [](Entry *) { return false; });
+  }
+
+  //  Moves live entries to the front of new arrays with room for half as
+  //  many again as `count`, closing holes and dropping erased index slots.
+  //  The index is kept at most 2/3 full. build(entry) may construct the
+  //  entry after the live ones and returns whether it did; it runs before
+  //  the old entries move, so its arguments may refer to them. The caller
+  //  indexes and counts that entry.
+  template <class Build>
+  void Resize(size_type count, Build build) {
+    size_type entry_capacity = std::max<size_type>(8, count + count / 2);
+    if (entry_capacity >= kErased) {
+      throw std::length_error("ordered_hash_map: too many entries");
+    }
+    size_type index_capacity = 16;
+    while (index_capacity * 2 < entry_capacity * 3) index_capacity *= 2;
+    Entry *entries = allocator_.allocate(entry_capacity);
+    std::uint32_t *index;
+    try {
+      index = IndexAllocator(allocator_).allocate(index_capacity);
+    } catch (...) {
+      allocator_.deallocate(entries, entry_capacity);
+      throw;
+    }
+    std::fill(index, index + index_capacity, kFree);
+    bool built;
+    try {
+      built = build(entries + size_);
+    } catch (...) {
+      Deallocate(entries, entry_capacity, index, index_capacity);
+      throw;
+    }
+    size_type moved = 0;
+    try {
+      for (size_type i = 0; i < used_; ++i) {
+        if (entries_[i].hash == kDead) continue;
+        std::allocator_traits<EntryAllocator>::construct(
+            allocator_, entries + moved, entries_[i].hash,
+            std::move_if_noexcept(entries_[i].value));
+        size_type slot = entries_[i].hash & (index_capacity - 1);
+        while (index[slot] != kFree) slot = (slot + 1) & (index_capacity - 1);
+        index[slot] = std::uint32_t(moved++);
+      }
+    } catch (...) {
+      for (size_type i = 0; i < moved; ++i) {
+        std::allocator_traits<EntryAllocator>::destroy(allocator_,
+                                                       entries + i);
+      }
+      if (built) {
+        std::allocator_traits<EntryAllocator>::destroy(allocator_,
+                                                       entries + size_);
+      }
+      Deallocate(entries, entry_capacity, index, index_capacity);
+      throw;
+    }
+    DestroyEntries();
+    Deallocate(entries_, entry_capacity_, index_, index_capacity_);
+    entries_ = entries;
+    entry_capacity_ = entry_capacity;
+    index_ = index;
+    index_capacity_ = index_capacity;
+    used_ = size_ = moved;
+  }
+
+  void DestroyEntries() {
+    for (size_type i = 0; i < used_; ++i) {
+      if (entries_[i].hash != kDead) {
+        std::allocator_traits<EntryAllocator>::destroy(allocator_,
+                                                       entries_ + i);
+      }
+    }
+    used_ = size_ = 0;
+  }
+
+  void Deallocate(Entry *entries, size_type entry_capacity,
+                  std::uint32_t *index, size_type index_capacity) {
+    if (entries == nullptr) return;
+    allocator_.deallocate(entries, entry_capacity);
+    IndexAllocator(allocator_).deallocate(index, index_capacity);
+  }
+};  // class ordered_hash_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_ORDERED_HASH_MAP_H_
@@ -0,0 +1,446 @@
+#ifndef CONTAINERS_SRC_S21_PERFECT_HASH_MAP_H_
+#define CONTAINERS_SRC_S21_PERFECT_HASH_MAP_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "s21_hash.h"
+
+namespace s21 {
+template <class Key, class T>
+struct PerfectHashEntry {
+  Key first;
+  T second;
+};
+
+//  Immutable map over a fixed key set, indexed by a BBHash minimal perfect
+//  hash. Level l is a bit array of about gamma * (keys left) bits; a key
+//  owns the bit it hashes to on the first level where no other remaining
+//  key hits that bit, and its entry index is the rank of that bit. Most
+//  keys settle on level 0, so a lookup usually reads one bit array word,
+//  one rank sample and the entry. Key and T are stored by bytes, so the
+//  whole table is one flat buffer that save() writes and load() maps.
+template <class Key, class T, class Hash = hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class perfect_hash_map {
+  static_assert(std::is_trivially_copyable<Key>::value &&
+                    std::is_trivially_copyable<T>::value,
+                "perfect_hash_map stores keys and values by bytes");
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = PerfectHashEntry<Key, T>;
+  using size_type = std::size_t;
+  //  Entries in hash order
+  using const_iterator = const value_type *;
+  using iterator = const_iterator;
+
+  perfect_hash_map() {}
+  //  Builds from distinct (key, value) pairs; threads = 0 uses every core.
+  //  Throws std::invalid_argument if keys repeat.
+  template <class RandomIt>
+  perfect_hash_map(RandomIt first, RandomIt last, double gamma = 2.0,
+                   unsigned threads = 0) {
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    try {
+      Build(first, size_type(std::distance(first, last)), std::max(gamma, 1.0),
+            threads);
+    } catch (...) {
+      Release();
+      throw;
+    }
+  }
+  perfect_hash_map(const perfect_hash_map &) = delete;
+  perfect_hash_map &operator=(const perfect_hash_map &) = delete;
+  perfect_hash_map(perfect_hash_map &&other) noexcept { Steal(other); }
+  perfect_hash_map &operator=(perfect_hash_map &&other) noexcept {
+    if (this != &other) {
+      Release();
+      Steal(other);
+    }
+    return *this;
+  }
+  ~perfect_hash_map() { Release(); }
+
+  const_iterator begin() const { return entries_; }
+  const_iterator end() const { return entries_ + size(); }
+  size_type size() const { return header_ ? header_->count : 0; }
+  bool empty() const { return size() == 0; }
+
+  //  The value for key, or nullptr; the stored key is compared, so keys
+  //  outside the set are rejected
+  const T *find(const Key &key) const {
+    if (empty()) return nullptr;
+    std::uint64_t index = IndexOfHash(Hash()(key));
+    if (index == kMissing || !KeyEqual()(entries_[index].first, key)) {
+      return nullptr;
+    }
+    return &entries_[index].second;
+  }
+
+  bool contains(const Key &key) const { return find(key) != nullptr; }
+
+  const T &at(const Key &key) const {
+    const T *value = find(key);
+    if (value == nullptr) {
+      throw std::out_of_range("Fail");
+    }
+    return *value;
+  }
+
+  //  Size of the hash levels and rank samples, not counting the entries
+  double bits_per_key() const {
+    if (empty()) return 0;
+    std::uint64_t words = level_start_[header_->levels];
+    return double(words + Blocks(words)) * 64 / header_->count;
+  }
+
+  void save(const std::string &path) const {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+    const unsigned char *data = data_;
+    size_type left = length_;
+    while (left != 0) {
+      ssize_t done = ::write(fd, data, left);
+      if (done < 0 && errno == EINTR) continue;
+      if (done < 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), path);
+      }
+      data += done;
+      left -= done;
+    }
+    if (::close(fd) != 0) {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+  }
+
+  //  Maps a file written by save() read-only; nothing is copied
+  static perfect_hash_map load(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+    off_t length = ::lseek(fd, 0, SEEK_END);
+    void *data = length > 0 ? ::mmap(nullptr, length, PROT_READ, MAP_SHARED,
+                                     fd, 0)
+                            : MAP_FAILED;
+    int error = errno;
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      throw std::system_error(length > 0 ? error : EINVAL,
+                              std::generic_category(), path);
+    }
+    perfect_hash_map map;
+    map.data_ = static_cast<unsigned char *>(data);
+    map.length_ = length;
+    map.mapped_ = true;
+    if (!map.Attach()) {
+      throw std::runtime_error("perfect_hash_map: bad file " + path);
+    }
+    return map;
+  }
+
+ private:
+  //  Changes with the file format and with the default Hash, so a file
+  //  whose keys were placed by another hasher is rejected, not misread
+  static constexpr std::uint64_t kMagic = 0x687068706D6D3232ull;
+  static constexpr std::uint64_t kMissing = ~std::uint64_t{};
+  static constexpr std::uint64_t kMaxLevels = 64;
+  //  One rank sample per 8 words
+  static constexpr std::uint64_t kBlockWords = 8;
+
+  struct Header {
+    std::uint64_t magic;
+    std::uint64_t key_size;
+    std::uint64_t value_size;
+    std::uint64_t count;
+    std::uint64_t levels;
+    std::uint64_t words;
+    std::uint64_t entries_offset;
+    std::uint64_t length;
+  };
+
+  unsigned char *data_{};
+  size_type length_{};
+  bool mapped_{};
+  const Header *header_{};
+  //  Level l covers words [level_start_[l], level_start_[l + 1])
+  const std::uint64_t *level_start_{};
+  const std::uint64_t *words_{};
+  const std::uint64_t *ranks_{};
+  const value_type *entries_{};
+
+  static std::uint64_t Blocks(std::uint64_t words) {
+    return words / kBlockWords + 1;
+  }
+
+  static size_type AlignUp(size_type offset) { return (offset + 63) & ~63ull; }
+
+  //  splitmix64 finalizer over the key hash and the level
+  static std::uint64_t LevelHash(std::uint64_t hash, std::uint64_t level) {
+    std::uint64_t x = hash + (level + 1) * 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+  }
+
+  //  Bit of key on a level of `bits` bits, by multiply-shift instead of %
+  static std::uint64_t Position(std::uint64_t hash, std::uint64_t level,
+                                std::uint64_t bits) {
+    return std::uint64_t(
+        (unsigned __int128)LevelHash(hash, level) * bits >> 64);
+  }
+
+  //  Entry index of the key with this hash, kMissing past the last level
+  std::uint64_t IndexOfHash(std::uint64_t hash) const {
+    for (std::uint64_t level = 0; level < header_->levels; ++level) {
+      std::uint64_t start = level_start_[level];
+      std::uint64_t bits = (level_start_[level + 1] - start) * 64;
+      std::uint64_t bit = start * 64 + Position(hash, level, bits);
+      if (words_[bit / 64] >> (bit % 64) & 1) return Rank(bit);
+    }
+    return kMissing;
+  }
+
+  //  Set bits before `bit`
+  std::uint64_t Rank(std::uint64_t bit) const {
+    std::uint64_t word = bit / 64;
+    std::uint64_t rank = ranks_[word / kBlockWords];
+    for (std::uint64_t w = word - word % kBlockWords; w < word; ++w) {
+      rank += __builtin_popcountll(words_[w]);
+    }
+    return rank +
+           __builtin_popcountll(words_[word] & ((1ull << (bit % 64)) - 1));
+  }
+
+  //  Checks a loaded file and points the section pointers into it, false
+  //  if the layout is off or the levels and rank samples disagree with the
+  //  bits, which would send lookups past the end of the sections
+  bool Attach() {
+    if (length_ < sizeof(Header)) return false;
+    header_ = reinterpret_cast<const Header *>(data_);
+    if (header_->magic != kMagic || header_->key_size != sizeof(Key) ||
+        header_->value_size != sizeof(T) || header_->length != length_ ||
+        header_->levels > kMaxLevels ||
+        //  Bounded by the file first, so the sizes below cannot wrap
+        header_->words > length_ / 8 ||
+        header_->count > length_ / sizeof(value_type) ||
+        Layout(header_->levels, header_->words) != header_->entries_offset ||
+        header_->entries_offset + header_->count * sizeof(value_type) !=
+            length_) {
+      header_ = nullptr;
+      return false;
+    }
+    Point();
+    if (!LevelsMatch() || !RanksMatch()) {
+      header_ = nullptr;
+      return false;
+    }
+    return true;
+  }
+
+  //  Points the section pointers into data_ as laid out by the header
+  void Point() {
+    header_ = reinterpret_cast<const Header *>(data_);
+    level_start_ =
+        reinterpret_cast<const std::uint64_t *>(data_ + sizeof(Header));
+    words_ = reinterpret_cast<const std::uint64_t *>(
+        data_ + AlignUp(sizeof(Header) + (header_->levels + 1) * 8));
+    ranks_ = words_ + header_->words;
+    entries_ =
+        reinterpret_cast<const value_type *>(data_ + header_->entries_offset);
+  }
+
+  //  Levels start at word 0, are never empty and end at the last word
+  bool LevelsMatch() const {
+    if (level_start_[0] != 0) return false;
+    for (std::uint64_t level = 0; level < header_->levels; ++level) {
+      if (level_start_[level + 1] <= level_start_[level]) return false;
+    }
+    return level_start_[header_->levels] == header_->words;
+  }
+
+  //  Every rank sample counts the bits before it, one bit per entry
+  bool RanksMatch() const {
+    std::uint64_t rank = 0;
+    for (std::uint64_t w = 0; w < header_->words; ++w) {
+      if (w % kBlockWords == 0 && ranks_[w / kBlockWords] != rank) {
+        return false;
+      }
+      rank += __builtin_popcountll(words_[w]);
+    }
+    return rank == header_->count;
+  }
+
+  //  Offset of the entries; the file ends after them
+  static size_type Layout(std::uint64_t levels, std::uint64_t words) {
+    size_type offset = AlignUp(sizeof(Header) + (levels + 1) * 8);
+    offset += (words + Blocks(words)) * 8;
+    return AlignUp(offset);
+  }
+
+  template <class Fn>
+  static void Parallel(size_type count, unsigned threads, Fn fn) {
+    size_type chunk = (count + threads - 1) / threads;
+    std::unique_ptr<std::future<void>[]> jobs(new std::future<void>[threads]);
+    for (unsigned t = 1; t < threads; ++t) {
+      size_type begin = std::min(count, t * chunk);
+      size_type end = std::min(count, begin + chunk);
+      jobs[t] = std::async(std::launch::async, fn, t, begin, end);
+    }
+    fn(0u, size_type{0}, std::min(count, chunk));
+    for (unsigned t = 1; t < threads; ++t) jobs[t].get();
+  }
+
+  template <class RandomIt>
+  void Build(RandomIt first, size_type count, double gamma, unsigned threads) {
+    threads = unsigned(std::min<size_type>(threads, count / 4096 + 1));
+    std::unique_ptr<std::uint64_t[]> hashes(new std::uint64_t[count]);
+    Parallel(count, threads, [&](unsigned, size_type begin, size_type end) {
+      for (size_type i = begin; i < end; ++i) {
+        hashes[i] = Hash()(first[i].first);
+      }
+    });
+    //  Hashes of the keys not placed yet, shrinking level by level
+    std::unique_ptr<std::uint64_t[]> left(new std::uint64_t[count]);
+    std::copy(hashes.get(), hashes.get() + count, left.get());
+    std::unique_ptr<std::uint64_t[]> level_words[kMaxLevels];
+    std::uint64_t level_start[kMaxLevels + 1] = {0};
+    std::uint64_t levels = 0;
+    std::unique_ptr<size_type[]> kept(new size_type[threads + 1]);
+    for (size_type remaining = count; remaining != 0; ++levels) {
+      if (levels == kMaxLevels) {
+        throw std::invalid_argument("perfect_hash_map: repeated keys");
+      }
+      std::uint64_t words = std::uint64_t(gamma * remaining) / 64 + 1;
+      std::uint64_t bits = words * 64;
+      std::unique_ptr<std::atomic<std::uint64_t>[]> seen(
+          new std::atomic<std::uint64_t>[words]());
+      std::unique_ptr<std::atomic<std::uint64_t>[]> clash(
+          new std::atomic<std::uint64_t>[words]());
+      Parallel(remaining, threads, [&](unsigned, size_type begin,
+                                       size_type end) {
+        for (size_type i = begin; i < end; ++i) {
+          std::uint64_t bit = Position(left[i], levels, bits);
+          std::uint64_t mask = 1ull << (bit % 64);
+          if (seen[bit / 64].fetch_or(mask, std::memory_order_relaxed) &
+              mask) {
+            clash[bit / 64].fetch_or(mask, std::memory_order_relaxed);
+          }
+        }
+      });
+      level_words[levels].reset(new std::uint64_t[words]);
+      for (std::uint64_t w = 0; w < words; ++w) {
+        level_words[levels][w] = seen[w].load(std::memory_order_relaxed) &
+                                 ~clash[w].load(std::memory_order_relaxed);
+      }
+      level_start[levels + 1] = level_start[levels] + words;
+      //  Keys that clashed move on; each chunk counts, then compacts
+      auto clashed = [&](size_type i) {
+        std::uint64_t bit = Position(left[i], levels, bits);
+        return (clash[bit / 64].load(std::memory_order_relaxed) >>
+                (bit % 64)) & 1;
+      };
+      Parallel(remaining, threads, [&](unsigned t, size_type begin,
+                                       size_type end) {
+        size_type n = 0;
+        for (size_type i = begin; i < end; ++i) n += clashed(i);
+        kept[t + 1] = n;
+      });
+      kept[0] = 0;
+      for (unsigned t = 0; t < threads; ++t) kept[t + 1] += kept[t];
+      std::unique_ptr<std::uint64_t[]> next(new std::uint64_t[kept[threads]]);
+      Parallel(remaining, threads, [&](unsigned t, size_type begin,
+                                       size_type end) {
+        size_type out = kept[t];
+        for (size_type i = begin; i < end; ++i) {
+          if (clashed(i)) next[out++] = left[i];
+        }
+      });
+      remaining = kept[threads];
+      left = std::move(next);
+    }
+    std::uint64_t words = level_start[levels];
+    size_type entries_offset = Layout(levels, words);
+    length_ = entries_offset + count * sizeof(value_type);
+    data_ = static_cast<unsigned char *>(::operator new(length_));
+    std::memset(data_, 0, length_);
+    Header header{kMagic, sizeof(Key), sizeof(T), count, levels, words,
+                  entries_offset, length_};
+    std::memcpy(data_, &header, sizeof(header));
+    std::memcpy(data_ + sizeof(Header), level_start, (levels + 1) * 8);
+    Point();
+    std::uint64_t *out = const_cast<std::uint64_t *>(words_);
+    for (std::uint64_t level = 0; level < levels; ++level) {
+      std::copy(level_words[level].get(),
+                level_words[level].get() + level_start[level + 1] -
+                    level_start[level],
+                out + level_start[level]);
+    }
+    std::uint64_t *ranks = const_cast<std::uint64_t *>(ranks_);
+    std::uint64_t rank = 0;
+    for (std::uint64_t w = 0; w < words; ++w) {
+      if (w % kBlockWords == 0) ranks[w / kBlockWords] = rank;
+      rank += __builtin_popcountll(out[w]);
+    }
+    value_type *entries = const_cast<value_type *>(entries_);
+    Parallel(count, threads, [&](unsigned, size_type begin, size_type end) {
+      for (size_type i = begin; i < end; ++i) {
+        std::uint64_t index = IndexOfHash(hashes[i]);
+        entries[index].first = first[i].first;
+        entries[index].second = first[i].second;
+      }
+    });
+  }
+
+  void Release() {
+    if (data_ == nullptr) return;
+    if (mapped_) {
+      ::munmap(data_, length_);
+    } else {
+      ::operator delete(data_);
+    }
+    data_ = nullptr;
+    header_ = nullptr;
+  }
+
+  void Steal(perfect_hash_map &other) {
+    data_ = other.data_;
+    length_ = other.length_;
+    mapped_ = other.mapped_;
+    header_ = other.header_;
+    level_start_ = other.level_start_;
+    words_ = other.words_;
+    ranks_ = other.ranks_;
+    entries_ = other.entries_;
+    other.data_ = nullptr;
+    other.header_ = nullptr;
+  }
+};  // class perfect_hash_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_PERFECT_HASH_MAP_H_
@@ -0,0 +1,377 @@
+#ifndef CONTAINERS_SRC_S21_PERSISTENT_MAP_H_
+#define CONTAINERS_SRC_S21_PERSISTENT_MAP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+namespace s21 {
+//  Ordered map whose nodes are immutable and shared between versions.
+//  Copying a map is an O(1) snapshot. Updates copy only the O(log n)
+//  nodes on the search path, so old snapshots stay valid and readable
+//  from other threads while this handle keeps changing. The shape is a
+//  treap, balanced in expectation whatever the insertion order.
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class persistent_map {
+ public:
+  class Node;
+  class PersistentIterator;
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = PersistentIterator;
+  using const_iterator = PersistentIterator;
+  using size_type = std::size_t;
+  using allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+  class Node {
+   public:
+    value_type value;
+    Node *left{};
+    Node *right{};
+    std::uint32_t priority{};
+    //  Number of parents and handles pointing here
+    mutable std::atomic<size_type> refs{1};
+    template <class... Args>
+    explicit Node(std::uint32_t prio, Args &&...args)
+        : value(std::forward<Args>(args)...), priority(prio) {}
+  };  //  class Node
+
+  //  Iterators stay valid as long as the version they came from is alive.
+  //  Each step is a fresh O(log n) descent, so they hold no extra state.
+  class PersistentIterator {
+    friend class persistent_map;
+
+   public:
+    using value_type = persistent_map::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    reference operator*() const { return current_node_->value; }
+    pointer operator->() const { return &(current_node_->value); }
+    bool operator==(const PersistentIterator &other) const {
+      return current_node_ == other.current_node_;
+    }
+    bool operator!=(const PersistentIterator &other) const {
+      return current_node_ != other.current_node_;
+    }
+    PersistentIterator &operator++() {
+      current_node_ = UpperBound(root_, current_node_->value.first);
+      return *this;
+    }
+    PersistentIterator operator++(int) {
+      PersistentIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+   private:
+    PersistentIterator(const Node *root, const Node *node)
+        : root_(root), current_node_(node) {}
+    const Node *root_;
+    const Node *current_node_;
+  };  //  class PersistentIterator
+
+  persistent_map() {}
+  persistent_map(std::initializer_list<value_type> const &items) {
+    for (auto it = items.begin(); it != items.end(); ++it) {
+      insert(it->first, it->second);
+    }
+  }
+  persistent_map(const persistent_map &other) noexcept
+      : root_(Retain(other.root_)),
+        size_(other.size_),
+        allocator_(other.allocator_) {}
+  persistent_map(persistent_map &&other) noexcept
+      : root_(other.root_), size_(other.size_), allocator_(other.allocator_) {
+    other.root_ = nullptr;
+    other.size_ = 0;
+  }
+  ~persistent_map() { Release(root_); }
+
+  persistent_map &operator=(const persistent_map &other) noexcept {
+    persistent_map copy(other);
+    swap(copy);
+    return *this;
+  }
+
+  persistent_map &operator=(persistent_map &&other) noexcept {
+    persistent_map moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  //  O(1), the returned version never changes
+  persistent_map snapshot() const noexcept { return *this; }
+
+  const_iterator begin() const {
+    const Node *node = root_;
+    while (node != nullptr && node->left != nullptr) node = node->left;
+    return const_iterator(root_, node);
+  }
+  const_iterator end() const { return const_iterator(root_, nullptr); }
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+
+  const_iterator find(const Key &key) const {
+    return const_iterator(root_, Search(key));
+  }
+  bool contains(const Key &key) const { return Search(key) != nullptr; }
+
+  const mapped_type &at(const Key &key) const {
+    const Node *node = Search(key);
+    if (node == nullptr) {
+      throw std::out_of_range("Fail");
+    }
+    return node->value.second;
+  }
+
+  //  Leaves the map untouched and returns false if the key is present
+  template <class K, class V>
+  bool insert(K &&key, V &&obj) {
+    if (Search(key) != nullptr) {
+      return false;
+    }
+    Replace(Insert(root_, key, std::forward<K>(key), std::forward<V>(obj)));
+    ++size_;
+    return true;
+  }
+
+  //  Returns true if the key was new
+  template <class K, class V>
+  bool insert_or_assign(K &&key, V &&obj) {
+    bool fresh = Search(key) == nullptr;
+    Replace(Insert(root_, key, std::forward<K>(key), std::forward<V>(obj)));
+    size_ += fresh;
+    return fresh;
+  }
+
+  bool erase(const Key &key) {
+    if (Search(key) == nullptr) {
+      return false;
+    }
+    Replace(Erase(root_, key));
+    --size_;
+    return true;
+  }
+
+  void clear() {
+    Release(root_);
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+  void swap(persistent_map &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(allocator_, other.allocator_);
+  }
+
+  //  True if both handles share one version, so they hold the same items
+  bool same_version(const persistent_map &other) const {
+    return root_ == other.root_;
+  }
+
+ private:
+  Node *root_{};
+  size_type size_{};
+  allocator_type allocator_{};
+
+  static bool Less(const Key &a, const Key &b, Compare cmp = Compare{}) {
+    return cmp(a, b);
+  }
+
+  const Node *Search(const Key &key) const {
+    const Node *node = root_;
+    while (node != nullptr) {
+      //  key < node->key
+      if (Less(key, node->value.first)) {
+        node = node->left;
+        //  node->key < key
+      } else if (Less(node->value.first, key)) {
+        node = node->right;
+      } else {
+        break;
+      }
+    }
+    return node;
+  }
+
+  static const Node *UpperBound(const Node *node, const Key &key) {
+    const Node *bound = nullptr;
+    while (node != nullptr) {
+      //  key < node->key
+      if (Less(key, node->value.first)) {
+        bound = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return bound;
+  }
+
+  static Node *Retain(Node *node) {
+    if (node != nullptr) node->refs.fetch_add(1, std::memory_order_relaxed);
+    return node;
+  }
+
+  void Release(Node *node) {
+    while (node != nullptr &&
+           node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Release(node->left);
+      Node *right = node->right;
+      std::allocator_traits<allocator_type>::destroy(allocator_, node);
+      std::allocator_traits<allocator_type>::deallocate(allocator_, node, 1);
+      node = right;
+    }
+  }
+
+  //  Takes ownership of a freshly built root
+  void Replace(Node *root) {
+    Release(root_);
+    root_ = root;
+  }
+
+  static std::uint32_t NextPriority() {
+    thread_local std::uint64_t state =
+        0x9E3779B97F4A7C15ull ^ reinterpret_cast<std::uintptr_t>(&state);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<std::uint32_t>(state >> 32);
+  }
+
+  template <class... Args>
+  Node *NewNode(std::uint32_t priority, Args &&...args) {
+    Node *node = std::allocator_traits<allocator_type>::allocate(allocator_, 1);
+    try {
+      std::allocator_traits<allocator_type>::construct(
+          allocator_, node, priority, std::forward<Args>(args)...);
+    } catch (...) {
+      std::allocator_traits<allocator_type>::deallocate(allocator_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  //  Rotations only ever touch fresh, unshared nodes
+  static Node *RotateRight(Node *node) {
+    Node *pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    return pivot;
+  }
+
+  static Node *RotateLeft(Node *node) {
+    Node *pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    return pivot;
+  }
+
+  //  Returns a new version of the subtree with the key set to the value
+  template <class K, class V>
+  Node *Insert(const Node *node, const Key &key, K &&new_key, V &&obj) {
+    if (node == nullptr) {
+      return NewNode(NextPriority(), std::forward<K>(new_key),
+                     std::forward<V>(obj));
+    }
+    //  key < node->key
+    if (Less(key, node->value.first)) {
+      Node *left =
+          Insert(node->left, key, std::forward<K>(new_key), std::forward<V>(obj));
+      return AttachLeft(node, left);
+    }
+    //  node->key < key
+    if (Less(node->value.first, key)) {
+      Node *right = Insert(node->right, key, std::forward<K>(new_key),
+                           std::forward<V>(obj));
+      return AttachRight(node, right);
+    }
+    Node *copy =
+        NewNode(node->priority, node->value.first, std::forward<V>(obj));
+    copy->left = Retain(node->left);
+    copy->right = Retain(node->right);
+    return copy;
+  }
+
+  Node *AttachLeft(const Node *node, Node *left) {
+    Node *copy{};
+    try {
+      copy = NewNode(node->priority, node->value);
+    } catch (...) {
+      Release(left);
+      throw;
+    }
+    copy->left = left;
+    copy->right = Retain(node->right);
+    return (left->priority > copy->priority) ? RotateRight(copy) : copy;
+  }
+
+  Node *AttachRight(const Node *node, Node *right) {
+    Node *copy{};
+    try {
+      copy = NewNode(node->priority, node->value);
+    } catch (...) {
+      Release(right);
+      throw;
+    }
+    copy->left = Retain(node->left);
+    copy->right = right;
+    return (right->priority > copy->priority) ? RotateLeft(copy) : copy;
+  }
+
+  //  The key must be present
+  Node *Erase(const Node *node, const Key &key) {
+    //  key < node->key
+    if (Less(key, node->value.first)) {
+      Node *left = Erase(node->left, key);
+      return WithChildren(node, left, Retain(node->right));
+    }
+    //  node->key < key
+    if (Less(node->value.first, key)) {
+      Node *right = Erase(node->right, key);
+      return WithChildren(node, Retain(node->left), right);
+    }
+    return Merge(node->left, node->right);
+  }
+
+  //  Fresh copy of `node` adopting two already owned children
+  Node *WithChildren(const Node *node, Node *left, Node *right) {
+    Node *copy{};
+    try {
+      copy = NewNode(node->priority, node->value);
+    } catch (...) {
+      Release(left);
+      Release(right);
+      throw;
+    }
+    copy->left = left;
+    copy->right = right;
+    return copy;
+  }
+
+  //  Every key of `a` is less than every key of `b`; both stay untouched
+  Node *Merge(Node *a, Node *b) {
+    if (a == nullptr) return Retain(b);
+    if (b == nullptr) return Retain(a);
+    if (a->priority > b->priority) {
+      Node *right = Merge(a->right, b);
+      return WithChildren(a, Retain(a->left), right);
+    }
+    Node *left = Merge(a, b->left);
+    return WithChildren(b, left, Retain(b->right));
+  }
+};  // class persistent_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_PERSISTENT_MAP_H_
@@ -0,0 +1,140 @@
+#ifndef CONTAINERS_SRC_S21_RCU_MAP_H_
+#define CONTAINERS_SRC_S21_RCU_MAP_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "s21_epoch.h"
+#include "s21_persistent_map.h"
+#include "s21_vector.h"
+
+namespace s21 {
+//  Read-mostly ordered map. Readers run against the current version under
+//  an EpochGuard: no lock and no store outside their own slot. Writers are
+//  serialized, path-copy a new persistent_map version and publish it with
+//  a single pointer swap; old versions are freed once no reader pins them.
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class rcu_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using version_type = persistent_map<Key, T, Compare, Allocator>;
+  using value_type = typename version_type::value_type;
+  using size_type = typename version_type::size_type;
+
+  rcu_map() : current_(new version_type) {}
+  rcu_map(std::initializer_list<value_type> const &items)
+      : current_(new version_type(items)) {}
+  rcu_map(const rcu_map &) = delete;
+  rcu_map &operator=(const rcu_map &) = delete;
+  //  No reader may still be inside read() when the map is destroyed
+  ~rcu_map() {
+    delete current_.load(std::memory_order_relaxed);
+    for (size_type i = 0; i < retired_.size(); ++i) {
+      delete retired_[i].first;
+    }
+  }
+
+  //  Calls fn(const persistent_map &) on the current version, lock free.
+  //  References into the version must not escape fn.
+  template <class Fn>
+  decltype(auto) read(Fn &&fn) const {
+    EpochGuard guard;
+    return std::forward<Fn>(fn)(*current_.load(std::memory_order_seq_cst));
+  }
+
+  bool contains(const Key &key) const {
+    return read([&key](const version_type &map) { return map.contains(key); });
+  }
+
+  //  Copies the value out, false if the key is missing
+  bool find(const Key &key, mapped_type &out) const {
+    return read([&](const version_type &map) {
+      auto it = map.find(key);
+      if (it == map.end()) return false;
+      out = it->second;
+      return true;
+    });
+  }
+
+  size_type size() const {
+    return read([](const version_type &map) { return map.size(); });
+  }
+  bool empty() const { return size() == 0; }
+
+  //  A version that stays readable after later updates, O(1)
+  version_type snapshot() const {
+    return read([](const version_type &map) { return map.snapshot(); });
+  }
+
+  template <class K, class V>
+  bool insert(K &&key, V &&obj) {
+    return update([&](version_type &map) {
+      return map.insert(std::forward<K>(key), std::forward<V>(obj));
+    });
+  }
+
+  template <class K, class V>
+  bool insert_or_assign(K &&key, V &&obj) {
+    return update([&](version_type &map) {
+      return map.insert_or_assign(std::forward<K>(key), std::forward<V>(obj));
+    });
+  }
+
+  bool erase(const Key &key) {
+    return update([&key](version_type &map) { return map.erase(key); });
+  }
+
+  //  Runs fn(persistent_map &) on a private copy of the current version and
+  //  publishes the result, so several changes become visible at once
+  template <class Fn>
+  auto update(Fn &&fn) -> decltype(fn(std::declval<version_type &>())) {
+    std::lock_guard<std::mutex> lock(writer_);
+    std::unique_ptr<version_type> next(new version_type(*current_.load()));
+    if constexpr (std::is_void_v<decltype(fn(*next))>) {
+      fn(*next);
+      Publish(next.get());
+      next.release();
+    } else {
+      auto result = fn(*next);
+      Publish(next.get());
+      next.release();
+      return result;
+    }
+  }
+
+ private:
+  std::atomic<version_type *> current_;
+  std::mutex writer_;
+  //  Unpublished versions waiting for readers to leave their epoch
+  s21::vector<std::pair<version_type *, EpochDomain::epoch_type>> retired_;
+
+  //  Cannot throw once the old version is swapped out
+  void Publish(version_type *next) {
+    if (retired_.size() == retired_.capacity()) {
+      retired_.reserve(retired_.capacity() ? 2 * retired_.capacity() : 8);
+    }
+    version_type *old = current_.exchange(next, std::memory_order_seq_cst);
+    retired_.push_back(std::make_pair(old, epoch_domain().retire_epoch()));
+    Collect();
+  }
+
+  void Collect() {
+    size_type kept = 0;
+    for (size_type i = 0; i < retired_.size(); ++i) {
+      if (epoch_domain().safe(retired_[i].second)) {
+        delete retired_[i].first;
+      } else {
+        retired_[kept++] = retired_[i];
+      }
+    }
+    while (retired_.size() > kept) retired_.pop_back();
+  }
+};  // class rcu_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_RCU_MAP_H_
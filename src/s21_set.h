@@ -37,10 +37,7 @@ class set : public BinaryTree<Key> {
   }
 
   set &operator=(set &&s) noexcept {
-    this->root_ = s.root_;
-    s.root_ = nullptr;
-    this->size_ = s.size_;
-    this->allocator_ = s.allocator_;
+    BinaryTree<Key>::operator=(std::move(s));
     return *this;
   }
 };  // class set
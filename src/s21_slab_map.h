@@ -0,0 +1,369 @@
+#ifndef CONTAINERS_SRC_S21_SLAB_MAP_H_
+#define CONTAINERS_SRC_S21_SLAB_MAP_H_
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_binary_tree.h"
+
+namespace s21 {
+//  What a slab_map node holds: the key and where its value lives
+template <class Key>
+struct SlabKey {
+  Key key;
+  std::size_t slot;
+};
+
+template <class Key, class Compare>
+struct SlabKeyLess {
+  bool operator()(const SlabKey<Key> &a, const SlabKey<Key> &b) const {
+    return Compare()(a.key, b.key);
+  }
+};
+
+//  Ordered map for large mapped types. Tree nodes hold only the key and a
+//  slot number; values sit densely in one slab, so a search touches no
+//  value bytes and values_begin()..values_end() walks them sequentially.
+//  Erase moves the last value into the freed slot. Iterators stay valid
+//  across inserts; references to values do not.
+template <class Key, class T, class Compare = std::less<Key>>
+class slab_map : BinaryTree<SlabKey<Key>, SlabKeyLess<Key, Compare>> {
+  using BTree = BinaryTree<SlabKey<Key>, SlabKeyLess<Key, Compare>>;
+  using Node = typename BTree::Node;
+
+ public:
+  template <bool Const>
+  class SlabIterator;
+  using key_type = Key;
+  using mapped_type = T;
+  using size_type = typename BTree::size_type;
+  using iterator = SlabIterator<false>;
+  using const_iterator = SlabIterator<true>;
+
+  //  Dereferences to a pair of references into the node and the slab
+  template <bool Const>
+  class SlabIterator {
+    friend class slab_map;
+    using Value = std::conditional_t<Const, const T, T>;
+    using Map = std::conditional_t<Const, const slab_map, slab_map>;
+
+   public:
+    using value_type = std::pair<const Key, T>;
+    using reference = std::pair<const Key &, Value &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+    struct pointer {
+      reference ref;
+      reference *operator->() { return &ref; }
+    };
+
+    SlabIterator() {}
+    SlabIterator(const SlabIterator<false> &other)
+        : map_(other.map_), node_(other.node_) {}
+
+    reference operator*() const {
+      return reference(node_->key.key, map_->values_[node_->key.slot]);
+    }
+    pointer operator->() const { return pointer{**this}; }
+    bool operator==(const SlabIterator &other) const {
+      return node_ == other.node_;
+    }
+    bool operator!=(const SlabIterator &other) const {
+      return node_ != other.node_;
+    }
+    SlabIterator &operator++() {
+      node_ = BTree::Next(node_);
+      return *this;
+    }
+    SlabIterator operator++(int) {
+      SlabIterator temp = *this;
+      node_ = BTree::Next(node_);
+      return temp;
+    }
+
+   private:
+    SlabIterator(Map *map, Node *node) : map_(map), node_(node) {}
+    Map *map_{};
+    Node *node_{};
+  };  //  class SlabIterator
+
+  slab_map() {}
+  slab_map(std::initializer_list<std::pair<const Key, T>> const &items) {
+    for (auto it = items.begin(); it != items.end(); ++it) {
+      insert(it->first, it->second);
+    }
+  }
+  slab_map(const slab_map &other) : BTree(other) {
+    try {
+      Reserve(other.count_);
+      for (; count_ < other.count_; ++count_) {
+        ::new (values_ + count_) T(other.values_[count_]);
+      }
+    } catch (...) {
+      clear();
+      Release();
+      throw;
+    }
+    Rebind();
+  }
+  slab_map(slab_map &&other) noexcept : BTree(std::move(other)) {
+    Steal(other);
+  }
+  slab_map &operator=(const slab_map &other) {
+    if (this != &other) {
+      slab_map copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+  slab_map &operator=(slab_map &&other) noexcept {
+    if (this != &other) {
+      clear();
+      Release();
+      BTree::operator=(std::move(other));
+      Steal(other);
+    }
+    return *this;
+  }
+  ~slab_map() {
+    clear();
+    Release();
+  }
+
+  iterator begin() { return iterator(this, BTree::leftmost_); }
+  iterator end() { return iterator(this, nullptr); }
+  const_iterator begin() const {
+    return const_iterator(this, BTree::leftmost_);
+  }
+  const_iterator end() const { return const_iterator(this, nullptr); }
+
+  //  Values in slab order, not key order
+  T *values_begin() { return values_; }
+  T *values_end() { return values_ + count_; }
+  const T *values_begin() const { return values_; }
+  const T *values_end() const { return values_ + count_; }
+
+  size_type size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+  size_type max_size() const {
+    return std::allocator_traits<std::allocator<T>>::max_size(allocator_);
+  }
+
+  iterator find(const Key &key) { return iterator(this, FindNode(key)); }
+  const_iterator find(const Key &key) const {
+    return const_iterator(this, FindNode(key));
+  }
+  bool contains(const Key &key) const { return FindNode(key) != nullptr; }
+
+  T &at(const Key &key) {
+    Node *node = FindNode(key);
+    if (node == nullptr) {
+      throw std::out_of_range("Fail");
+    }
+    return values_[node->key.slot];
+  }
+  const T &at(const Key &key) const {
+    return const_cast<slab_map *>(this)->at(key);
+  }
+
+  T &operator[](const Key &key) { return (*Emplace(key).first).second; }
+
+  std::pair<iterator, bool> insert(const std::pair<const Key, T> &value) {
+    return Emplace(value.first, value.second);
+  }
+  template <class V>
+  std::pair<iterator, bool> insert(const Key &key, V &&obj) {
+    return Emplace(key, std::forward<V>(obj));
+  }
+  template <class V>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, V &&obj) {
+    Node *node = FindNode(key);
+    if (node == nullptr) return Emplace(key, std::forward<V>(obj));
+    values_[node->key.slot] = std::forward<V>(obj);
+    return std::make_pair(iterator(this, node), false);
+  }
+  //  The value is built in place in the slab
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return Emplace(key, std::forward<Args>(args)...);
+  }
+
+  //  erase(end()) does nothing
+  void erase(iterator pos) {
+    Node *node = pos.node_;
+    if (node == nullptr) return;
+    size_type slot = node->key.slot;
+    BTree::erase(typename BTree::iterator(node));
+    --count_;
+    if (slot != count_) {
+      values_[slot] = std::move(values_[count_]);
+      owners_[slot] = owners_[count_];
+      owners_[slot]->key.slot = slot;
+    }
+    values_[count_].~T();
+  }
+  size_type erase(const Key &key) {
+    Node *node = FindNode(key);
+    if (node == nullptr) return 0;
+    erase(iterator(this, node));
+    return 1;
+  }
+
+  void clear() {
+    BTree::clear();
+    for (size_type i = 0; i < count_; ++i) values_[i].~T();
+    count_ = 0;
+  }
+
+  void swap(slab_map &other) noexcept {
+    BTree::swap(other);
+    std::swap(values_, other.values_);
+    std::swap(owners_, other.owners_);
+    std::swap(count_, other.count_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  //  Room for `count` entries without moving the slab
+  void reserve(size_type count) { Reserve(count); }
+
+ private:
+  T *values_{};
+  //  owners_[i] is the node whose value is in slot i
+  Node **owners_{};
+  size_type count_{};
+  size_type capacity_{};
+  std::allocator<T> allocator_;
+  std::allocator<Node *> owner_allocator_;
+
+  //  Reads keys only
+  Node *FindNode(const Key &key) const {
+    Node *node = BTree::root_;
+    while (node != nullptr) {
+      if (Compare()(key, node->key.key)) {
+        node = node->left;
+      } else if (Compare()(node->key.key, key)) {
+        node = node->right;
+      } else {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> Emplace(const Key &key, Args &&...args) {
+    Node *parent = nullptr;
+    Node **link = &this->root_;
+    while (*link != nullptr) {
+      parent = *link;
+      if (Compare()(key, parent->key.key)) {
+        link = &parent->left;
+      } else if (Compare()(parent->key.key, key)) {
+        link = &parent->right;
+      } else {
+        return std::make_pair(iterator(this, parent), false);
+      }
+    }
+    auto build = [&](T *slot) {
+      ::new (slot) T(std::forward<Args>(args)...);
+      return true;
+    };
+    if (count_ == capacity_) {
+      Grow(capacity_ ? 2 * capacity_ : 8, build);
+    } else {
+      build(values_ + count_);
+    }
+    Node *node;
+    try {
+      node = BTree::NewNode(SlabKey<Key>{key, count_});
+    } catch (...) {
+      values_[count_].~T();
+      throw;
+    }
+    BTree::Attach(node, parent, link);
+    owners_[count_++] = node;
+    return std::make_pair(iterator(this, node), true);
+  }
+
+  void Reserve(size_type count) {
+    if (count <= capacity_) return;
+    Grow(count, [](T *) { return false; });
+  }
+
+  //  Moves the slab to `count` > capacity_ slots. build(slot) may construct
+  //  the value of the next free slot and returns whether it did; it runs
+  //  before the old values move, so its arguments may refer to them.
+  template <class Build>
+  void Grow(size_type count, Build build) {
+    T *values = allocator_.allocate(count);
+    Node **owners;
+    try {
+      owners = owner_allocator_.allocate(count);
+    } catch (...) {
+      allocator_.deallocate(values, count);
+      throw;
+    }
+    bool built;
+    try {
+      built = build(values + count_);
+    } catch (...) {
+      allocator_.deallocate(values, count);
+      owner_allocator_.deallocate(owners, count);
+      throw;
+    }
+    size_type moved = 0;
+    try {
+      for (; moved < count_; ++moved) {
+        ::new (values + moved) T(std::move_if_noexcept(values_[moved]));
+      }
+    } catch (...) {
+      for (size_type i = 0; i < moved; ++i) values[i].~T();
+      if (built) values[count_].~T();
+      allocator_.deallocate(values, count);
+      owner_allocator_.deallocate(owners, count);
+      throw;
+    }
+    for (size_type i = 0; i < count_; ++i) {
+      values_[i].~T();
+      owners[i] = owners_[i];
+    }
+    Release();
+    values_ = values;
+    owners_ = owners;
+    capacity_ = count;
+  }
+
+  //  Frees the slab, its values must already be destroyed
+  void Release() {
+    if (capacity_ == 0) return;
+    allocator_.deallocate(values_, capacity_);
+    owner_allocator_.deallocate(owners_, capacity_);
+    values_ = nullptr;
+    owners_ = nullptr;
+    capacity_ = 0;
+  }
+
+  void Steal(slab_map &other) {
+    values_ = other.values_;
+    owners_ = other.owners_;
+    count_ = other.count_;
+    capacity_ = other.capacity_;
+    other.values_ = nullptr;
+    other.owners_ = nullptr;
+    other.count_ = other.capacity_ = 0;
+  }
+
+  //  Points owners_ at the nodes of a freshly copied tree
+  void Rebind() {
+    for (Node *node = BTree::leftmost_; node != nullptr;
+         node = BTree::Next(node)) {
+      owners_[node->key.slot] = node;
+    }
+  }
+};  // class slab_map
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_SLAB_MAP_H_
@@ -0,0 +1,156 @@
+#ifndef CONTAINERS_SRC_S21_STATIC_MAP_H_
+#define CONTAINERS_SRC_S21_STATIC_MAP_H_
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+template <class Key, class T>
+struct StaticEntry {
+  Key first;
+  T second;
+};
+
+//  Sorting and lookup shared by static_map and static_set. Items sit in one
+//  sorted array and a lookup is a binary search whose only branch is the
+//  loop, so the compiler can turn each step into a conditional move.
+template <class Value, std::size_t N, class KeyOf, class Compare>
+class StaticTable {
+ public:
+  using value_type = Value;
+  using size_type = std::size_t;
+  using const_iterator = const Value *;
+  using iterator = const_iterator;
+
+  constexpr const_iterator begin() const { return items_; }
+  constexpr const_iterator end() const { return items_ + N; }
+  constexpr size_type size() const { return N; }
+  constexpr bool empty() const { return N == 0; }
+
+  template <class K>
+  constexpr const_iterator lower_bound(const K &key) const {
+    if (N == 0) return end();
+    const Value *first = items_;
+    for (size_type n = N; n > 1; n -= n / 2) {
+      first = Less(KeyOf()(first[n / 2]), key) ? first + n / 2 : first;
+    }
+    return first + Less(KeyOf()(*first), key);
+  }
+
+  template <class K>
+  constexpr const_iterator find(const K &key) const {
+    const_iterator it = lower_bound(key);
+    return (it == end() || Less(key, KeyOf()(*it))) ? end() : it;
+  }
+
+  template <class K>
+  constexpr bool contains(const K &key) const {
+    return find(key) != end();
+  }
+
+  template <class K>
+  constexpr size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+ protected:
+  Value items_[N > 0 ? N : 1]{};
+
+  //  Insertion sort, meant for the small tables this class is for. A
+  //  duplicate key throws, which fails a constexpr construction outright.
+  template <class Source>
+  constexpr explicit StaticTable(const Source (&items)[N]) {
+    for (size_type i = 0; i < N; ++i) {
+      Value item = Convert(items[i]);
+      size_type j = i;
+      for (; j > 0 && Less(KeyOf()(item), KeyOf()(items_[j - 1])); --j) {
+        items_[j] = items_[j - 1];
+      }
+      if (j > 0 && !Less(KeyOf()(items_[j - 1]), KeyOf()(item))) {
+        throw std::invalid_argument("static table: duplicate key");
+      }
+      items_[j] = item;
+    }
+  }
+
+ private:
+  template <class A, class B>
+  static constexpr bool Less(const A &a, const B &b) {
+    return Compare()(a, b);
+  }
+
+  template <class Source>
+  static constexpr Value Convert(const Source &item) {
+    if constexpr (std::is_same_v<Source, Value>) {
+      return item;
+    } else {
+      return Value{item.first, item.second};
+    }
+  }
+};
+
+template <class Key, class T>
+struct StaticEntryKey {
+  constexpr const Key &operator()(const StaticEntry<Key, T> &entry) const {
+    return entry.first;
+  }
+};
+
+template <class Key>
+struct StaticSetKey {
+  constexpr const Key &operator()(const Key &key) const { return key; }
+};
+
+//  Immutable map sorted at compile time, with no heap use:
+//    constexpr s21::static_map<int, std::string_view, 3> kNames{
+//        {{3, "c"}, {1, "a"}, {2, "b"}}};
+//  Key and T must be literal types with constexpr assignment.
+template <class Key, class T, std::size_t N, class Compare = std::less<>>
+class static_map : public StaticTable<StaticEntry<Key, T>, N,
+                                      StaticEntryKey<Key, T>, Compare> {
+  using Table =
+      StaticTable<StaticEntry<Key, T>, N, StaticEntryKey<Key, T>, Compare>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+
+  constexpr static_map(const std::pair<Key, T> (&items)[N]) : Table(items) {}
+
+  template <class K>
+  constexpr const T &at(const K &key) const {
+    auto it = Table::find(key);
+    if (it == Table::end()) {
+      throw std::out_of_range("Fail");
+    }
+    return it->second;
+  }
+};
+
+//  Immutable set sorted at compile time, see static_map
+template <class Key, std::size_t N, class Compare = std::less<>>
+class static_set : public StaticTable<Key, N, StaticSetKey<Key>, Compare> {
+  using Table = StaticTable<Key, N, StaticSetKey<Key>, Compare>;
+
+ public:
+  using key_type = Key;
+
+  constexpr static_set(const Key (&items)[N]) : Table(items) {}
+};
+
+template <class Key, class T, std::size_t N>
+constexpr static_map<Key, T, N> make_static_map(
+    const std::pair<Key, T> (&items)[N]) {
+  return static_map<Key, T, N>(items);
+}
+
+template <class Key, std::size_t N>
+constexpr static_set<Key, N> make_static_set(const Key (&items)[N]) {
+  return static_set<Key, N>(items);
+}
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_STATIC_MAP_H_
@@ -0,0 +1,50 @@
+#ifndef CONTAINERS_SRC_S21_TREE_STATS_H_
+#define CONTAINERS_SRC_S21_TREE_STATS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+//  Process-wide tree counters. They are only collected when every
+//  translation unit is built with -DS21_TREE_STATS, otherwise the hooks
+//  expand to nothing.
+
+namespace s21 {
+struct TreeCounters {
+  std::atomic<std::uint64_t> comparisons{};
+  std::atomic<std::uint64_t> node_allocations{};
+  std::atomic<std::uint64_t> node_deallocations{};
+};
+
+inline TreeCounters &tree_counters() {
+  static TreeCounters counters;
+  return counters;
+}
+
+inline void reset_tree_counters() {
+  tree_counters().comparisons = 0;
+  tree_counters().node_allocations = 0;
+  tree_counters().node_deallocations = 0;
+}
+
+//  Writes the counters as a single JSON object
+inline void dump_tree_counters(std::ostream &out) {
+#ifdef S21_TREE_STATS
+  const TreeCounters &counters = tree_counters();
+  out << "{\"enabled\":true,\"comparisons\":" << counters.comparisons
+      << ",\"node_allocations\":" << counters.node_allocations
+      << ",\"node_deallocations\":" << counters.node_deallocations << "}";
+#else
+  out << "{\"enabled\":false}";
+#endif
+}
+}  // namespace s21
+
+#ifdef S21_TREE_STATS
+#define S21_TREE_COUNT(counter) \
+  ::s21::tree_counters().counter.fetch_add(1, std::memory_order_relaxed)
+#else
+#define S21_TREE_COUNT(counter) ((void)0)
+#endif
+
+#endif  // CONTAINERS_SRC_S21_TREE_STATS_H_
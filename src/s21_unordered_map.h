@@ -0,0 +1,118 @@
+#ifndef CONTAINERS_SRC_S21_UNORDERED_MAP_H_
+#define CONTAINERS_SRC_S21_UNORDERED_MAP_H_
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+template <class Key, class T>
+struct MapKeyOf {
+  const Key &operator()(const std::pair<const Key, T> &item) const {
+    return item.first;
+  }
+};
+
+//  Hash map on the Swiss table in s21_hash_table.h. Iterators and
+//  references are invalidated by any insert that rehashes, and with
+//  Incremental by any insert or erase by key while migrating().
+template <class Key, class T, class Hash = hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>,
+          bool Incremental = false>
+class unordered_map
+    : public HashTable<Key, std::pair<const Key, T>, MapKeyOf<Key, T>, Hash,
+                       KeyEqual, Allocator, Incremental> {
+  using Table = HashTable<Key, std::pair<const Key, T>, MapKeyOf<Key, T>,
+                          Hash, KeyEqual, Allocator, Incremental>;
+
+ public:
+  using mapped_type = T;
+  using value_type = typename Table::value_type;
+  using iterator = typename Table::iterator;
+  using const_iterator = typename Table::const_iterator;
+  using size_type = typename Table::size_type;
+
+  unordered_map() {}
+  unordered_map(std::initializer_list<value_type> const &items)
+      : Table(items) {}
+
+  mapped_type &at(const Key &key) {
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("Fail");
+    }
+    return it->second;
+  }
+  const mapped_type &at(const Key &key) const {
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("Fail");
+    }
+    return it->second;
+  }
+
+  mapped_type &operator[](const Key &key) {
+    return try_emplace(key).first->second;
+  }
+  mapped_type &operator[](Key &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return this->TryEmplace(key, std::piecewise_construct,
+                            std::forward_as_tuple(key),
+                            std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return this->TryEmplace(key, std::piecewise_construct,
+                            std::forward_as_tuple(std::move(key)),
+                            std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <class V>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, V &&obj) {
+    auto result = try_emplace(key, std::forward<V>(obj));
+    if (!result.second) result.first->second = std::forward<V>(obj);
+    return result;
+  }
+  template <class V>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, V &&obj) {
+    auto result = try_emplace(std::move(key), std::forward<V>(obj));
+    if (!result.second) result.first->second = std::forward<V>(obj);
+    return result;
+  }
+
+  using Table::insert;
+  //  The pair is built once, directly inside the slot
+  template <class K, class V,
+            std::enable_if_t<!std::is_convertible_v<K, const_iterator>,
+                             int> = 0>
+  std::pair<iterator, bool> insert(K &&key, V &&obj) {
+    const Key &probe = key;
+    return this->TryEmplace(probe, std::forward<K>(key), std::forward<V>(obj));
+  }
+
+  //  Builds the pair first, since the key is only known afterwards
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return this->TryEmplace(value.first, std::move(value));
+  }
+};  // class unordered_map
+
+//  Spreads each resize over the inserts that follow it, for callers that
+//  care about the worst insert more than the average one
+template <class Key, class T, class Hash = hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+using incremental_unordered_map =
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, true>;
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_UNORDERED_MAP_H_
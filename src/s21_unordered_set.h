@@ -0,0 +1,65 @@
+#ifndef CONTAINERS_SRC_S21_UNORDERED_SET_H_
+#define CONTAINERS_SRC_S21_UNORDERED_SET_H_
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+template <class Key>
+struct SetKeyOf {
+  const Key &operator()(const Key &key) const { return key; }
+};
+
+//  Hash set on the Swiss table in s21_hash_table.h. Elements are
+//  immutable through iterators, as in std::unordered_set.
+template <class Key, class Hash = hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<Key>, bool Incremental = false>
+class unordered_set : public HashTable<Key, Key, SetKeyOf<Key>, Hash,
+                                       KeyEqual, Allocator, Incremental> {
+  using Table = HashTable<Key, Key, SetKeyOf<Key>, Hash, KeyEqual, Allocator,
+                          Incremental>;
+
+ public:
+  using iterator = typename Table::const_iterator;
+  using const_iterator = typename Table::const_iterator;
+
+  unordered_set() {}
+  unordered_set(std::initializer_list<Key> const &items) : Table(items) {}
+
+  iterator begin() const { return Table::begin(); }
+  iterator end() const { return Table::end(); }
+
+  iterator find(const Key &key) const { return Table::find(key); }
+  template <class K, class = typename Table::template Heterogeneous<K>>
+  iterator find(const K &key) const {
+    return Table::find(key);
+  }
+
+  using Table::insert;
+  std::pair<iterator, bool> insert(const Key &key) {
+    return Table::insert(key);
+  }
+  std::pair<iterator, bool> insert(Key &&key) {
+    return Table::insert(std::move(key));
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    Key key(std::forward<Args>(args)...);
+    return this->TryEmplace(key, std::move(key));
+  }
+};  // class unordered_set
+
+//  See incremental_unordered_map
+template <class Key, class Hash = hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<Key>>
+using incremental_unordered_set =
+    unordered_set<Key, Hash, KeyEqual, Allocator, true>;
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_UNORDERED_SET_H_
@@ -1,7 +1,24 @@
 #ifndef CONTAINERS_SRC_VECTOR_H_
 #define CONTAINERS_SRC_VECTOR_H_
 
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
 namespace s21 {
+//  True when moving a T to a new address and dropping the original is the
+//  same as copying its bytes. Types that own a buffer but hold no pointer
+//  into themselves (most smart pointers and handles) may opt in:
+//    template <> struct s21::is_trivially_relocatable<Handle>
+//        : std::true_type {};
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
 template <class T, class Allocator = std::allocator<T>>
 class vector {
  public:
@@ -43,7 +60,7 @@ class vector {
     size_ = capacity_ = v.size_;
   }
 
-  vector(vector &&v)
+  vector(vector &&v) noexcept
       : array_(v.array_), size_(v.size_), capacity_(v.capacity_) {
     v.array_ = nullptr;
     v.size_ = v.capacity_ = 0;
@@ -68,7 +85,7 @@ class vector {
     return *this;
   }
 
-  vector &operator=(vector &&v) {
+  vector &operator=(vector &&v) noexcept {
     clear();
     allocator_traits::deallocate(alloc_, array_, capacity_);
     array_ = v.array_;
@@ -82,7 +99,7 @@ class vector {
   }
 
   void reserve(size_type size) {
-    if (size < capacity_) return;
+    if (size <= capacity_) return;
 
     reserve_capacity(size);
   }
@@ -124,15 +141,34 @@ class vector {
     return insert_many(pos, value);
   }
 
+  //  Shifts the tail down by move-assignment, as std::vector does, so a
+  //  throwing assignment still leaves every slot holding an element
   void erase(iterator pos) {
-    for (auto it = pos; it != end() - 1; ++it) {
-      *it = *(it + 1);
+    if constexpr (kRelocatable) {
+      allocator_traits::destroy(alloc_, pos);
+      Relocate(pos + 1, end() - pos - 1, pos);
+    } else {
+      std::move(pos + 1, end(), pos);
+      allocator_traits::destroy(alloc_, end() - 1);
     }
-    allocator_traits::destroy(alloc_, array_ + size_);
     --size_;
   }
 
-  void push_back(const_reference value) { insert_many(end(), value); }
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  //  Constructs the element in place from args
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    return Insert<1>(pos - array_, [&](T *slot) {
+      allocator_traits::construct(alloc_, slot, std::forward<Args>(args)...);
+    });
+  }
 
   void pop_back() {
     if (size_ > 0) {
@@ -152,33 +188,26 @@ class vector {
     std::swap(capacity_, other.capacity_);
   }
 
+  //  Constructs one element from each argument, in place and in order
   template <typename... Args>
   iterator insert_many(const_iterator pos, Args &&...args) {
-    size_type pos_diff = pos - begin();
-    size_type arg_count = sizeof...(args);
-    size_type newcap = get_capacity(capacity_, arg_count);
-
-    if (newcap != capacity_) reserve_capacity(newcap);
-    iterator insert_pos = begin() + pos_diff;
-
-    for (auto it = end() - 1 + arg_count, it2 = end() - 1;
-         it2 != insert_pos - 1; --it, --it2) {
-      allocator_traits::construct(alloc_, it, *(it2));
-    }
-
-    auto it = insert_pos;
-    for (auto i : {std::forward<Args>(args)...}) {
-      allocator_traits::construct(alloc_, it, i);
-      ++it;
-    }
-
-    size_ += arg_count;
-    return insert_pos;
+    return Insert<sizeof...(args)>(pos - array_, [&](T *slot) {
+      size_type built = 0;
+      try {
+        ((allocator_traits::construct(alloc_, slot + built,
+                                      std::forward<Args>(args)),
+          ++built),
+         ...);
+      } catch (...) {
+        Destroy(slot, built);
+        throw;
+      }
+    });
   }
 
   template <typename... Args>
   void insert_many_back(Args &&...args) {
-    insert_many(end(), args...);
+    insert_many(end(), std::forward<Args>(args)...);
   }
 
  private:
@@ -187,25 +216,128 @@ class vector {
   size_type capacity_;
   allocator_type alloc_;
 
+  //  Bytes may stand in for move and destroy only when the allocator does
+  //  not customize construction
+  static constexpr bool kRelocatable =
+      is_trivially_relocatable<T>::value &&
+      std::is_same_v<Allocator, std::allocator<T>>;
+  //  Whether Relocate can shift elements within the buffer without
+  //  throwing, and so without leaving a hole behind
+  static constexpr bool kNothrowShift =
+      kRelocatable || std::is_nothrow_move_constructible_v<T>;
+
+  //  Moves count elements from src to the unconstructed dst, leaving src
+  //  unconstructed; the ranges may overlap
+  void Relocate(T *src, size_type count, T *dst) {
+    if (count == 0 || src == dst) return;
+    if constexpr (kRelocatable) {
+      std::memmove(static_cast<void *>(dst), static_cast<const void *>(src),
+                   count * sizeof(T));
+    } else if (dst > src) {
+      for (size_type i = count; i-- > 0;) {
+        allocator_traits::construct(alloc_, dst + i,
+                                    std::move_if_noexcept(src[i]));
+        allocator_traits::destroy(alloc_, src + i);
+      }
+    } else {
+      for (size_type i = 0; i < count; ++i) {
+        allocator_traits::construct(alloc_, dst + i,
+                                    std::move_if_noexcept(src[i]));
+        allocator_traits::destroy(alloc_, src + i);
+      }
+    }
+  }
+
+  void Destroy(T *first, size_type count) {
+    for (size_type i = 0; i < count; ++i) {
+      allocator_traits::destroy(alloc_, first + i);
+    }
+  }
+
+  //  Builds count elements in the fresh buffer dst from src, moving when
+  //  that cannot throw. On an exception the built ones are destroyed and
+  //  src is untouched; otherwise src is ended with Retire.
+  void Transfer(T *src, size_type count, T *dst) {
+    if constexpr (kRelocatable) {
+      if (count != 0) {
+        std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                    count * sizeof(T));
+      }
+    } else {
+      size_type i = 0;
+      try {
+        for (; i < count; ++i) {
+          allocator_traits::construct(alloc_, dst + i,
+                                      std::move_if_noexcept(src[i]));
+        }
+      } catch (...) {
+        Destroy(dst, i);
+        throw;
+      }
+    }
+  }
+
+  void Retire(T *src, size_type count) {
+    if constexpr (!kRelocatable) Destroy(src, count);
+  }
+
+  //  Opens Count slots at offset and fills them with build, which must
+  //  construct all of them or none. The arguments may refer to any element,
+  //  or into one, so they are always consumed before an old element moves:
+  //  into a fresh buffer when the vector grows or shifting could throw,
+  //  otherwise into a side buffer that is relocated into the opened gap.
+  template <size_type Count, class Build>
+  iterator Insert(size_type offset, Build build) {
+    if (size_ + Count > capacity_ || (!kNothrowShift && offset != size_)) {
+      size_type newcap = get_capacity(capacity_, Count);
+      T *newarr = allocator_traits::allocate(alloc_, newcap);
+      T *slot = newarr + offset;
+      try {
+        build(slot);
+        try {
+          Transfer(array_, offset, newarr);
+          try {
+            Transfer(array_ + offset, size_ - offset, slot + Count);
+          } catch (...) {
+            Destroy(newarr, offset);
+            throw;
+          }
+        } catch (...) {
+          Destroy(slot, Count);
+          throw;
+        }
+      } catch (...) {
+        allocator_traits::deallocate(alloc_, newarr, newcap);
+        throw;
+      }
+      Retire(array_, size_);
+      allocator_traits::deallocate(alloc_, array_, capacity_);
+      array_ = newarr;
+      capacity_ = newcap;
+    } else if (offset == size_) {
+      build(array_ + offset);
+    } else {
+      alignas(T) unsigned char aside[(Count ? Count : 1) * sizeof(T)];
+      T *built = reinterpret_cast<T *>(aside);
+      build(built);
+      Relocate(array_ + offset, size_ - offset, array_ + offset + Count);
+      Relocate(built, Count, array_ + offset);
+    }
+    size_ += Count;
+    return array_ + offset;
+  }
+
+  //  Moves the elements if that cannot throw, otherwise copies them so a
+  //  throwing copy leaves the vector as it was
   void reserve_capacity(size_type size) {
     value_type *newarr = allocator_traits::allocate(alloc_, size);
-
-    size_type i = 0;
     try {
-      for (; i < size_; ++i) {
-        allocator_traits::construct(alloc_, newarr + i, array_[i]);
-      }
+      Transfer(array_, size_, newarr);
     } catch (...) {
-      for (size_type j = 0; j < i; ++j) {
-        allocator_traits::destroy(alloc_, newarr + i);
-      }
       allocator_traits::deallocate(alloc_, newarr, size);
       throw;
     }
-
-    for (size_type i = 0; i < size_; ++i) {
-      allocator_traits::destroy(alloc_, newarr + i);
-    }
+    Retire(array_, size_);
     allocator_traits::deallocate(alloc_, array_, capacity_);
 
     array_ = newarr;
@@ -213,6 +345,7 @@ class vector {
   }
 
   size_type get_capacity(size_type capacity, size_type arg_count = 0) {
+    if (capacity == 0) capacity = size_ + arg_count;
     while (size_ + arg_count > capacity) capacity *= 2;
     return capacity;
   }